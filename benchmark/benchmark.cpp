@@ -0,0 +1,772 @@
+// benchmark.cpp : Compares ranges_util views against hand-written loops.
+//
+
+#include "benchmark.h"
+#include "cartesian_product.h"
+#include "chunk_by.h"
+#include "cycle.h"
+#include "enumerate.h"
+#include "generator.h"
+#include "hash_join.h"
+#include "parallel.h"
+#include "scan.h"
+#include "slide.h"
+#include "stride.h"
+#include "strided_nd.h"
+#include "tiled_cartesian_product.h"
+#include "to.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <list>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+//Counts every allocation of the program for bench::count_allocations
+void* operator new(std::size_t size)
+{
+	bench::allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto const p{ std::malloc(std::max<std::size_t>(size, 1)) })
+	{
+		return p;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace
+{
+	//Single-pass base: every pass needs a new coroutine, so the view and the loop both pay for its frame
+	generator<int> iota_generator(int n)
+	{
+		for (int i{ 0 }; i < n; ++i)
+		{
+			co_yield i;
+		}
+	}
+
+	//Every view of ranges_util over one kind of base, each against the loop it stands for
+	//source() makes the base for one pass; views that need a forward range are skipped for single-pass bases
+	template <typename Source>
+	void coverage_benchmarks(bench::comparison_suite& suite, std::string const& base, std::size_t n, Source source)
+	{
+		using R = decltype(source());
+
+		auto const suffix{ " " + base + " " + std::to_string(n) };
+
+		suite.compare("enumerate" + suffix, n,
+			[&] {
+				long long sum{ 0 };
+
+				for (auto const [i, e] : source() | views::enumerate)
+				{
+					sum += static_cast<long long>(i) * e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				std::size_t i{ 0 };
+
+				for (auto e : source())
+				{
+					sum += static_cast<long long>(i++) * e;
+				}
+
+				bench::do_not_optimize(sum);
+			});
+
+		suite.compare("stride(3)" + suffix, n / 3,
+			[&] {
+				long long sum{ 0 };
+
+				for (auto e : source() | views::stride(3))
+				{
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				auto r{ source() };
+
+				for (auto it{ std::ranges::begin(r) }; it != std::ranges::end(r); std::ranges::advance(it, 3, std::ranges::end(r)))
+				{
+					sum += *it;
+				}
+
+				bench::do_not_optimize(sum);
+			});
+
+		auto const same_block{ [](int x, int y) { return x / 16 == y / 16; } };
+
+		suite.compare("chunk_by" + suffix, n,
+			[&] {
+				long long sum{ 0 };
+
+				for (auto&& chunk : source() | views::chunk_by(same_block))
+				{
+					++sum;
+
+					for (auto e : chunk)
+					{
+						sum += e;
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				std::optional<int> previous;
+
+				for (auto e : source())
+				{
+					if (!previous || !same_block(*previous, e))
+					{
+						++sum;
+					}
+
+					previous = e;
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			});
+
+		//Known slow over a vector, about 2x to 2.7x at 4096 and up: to<> fills a reserved vector through std::inserter, which
+		//calls insert() at the end once per element, while the loop calls push_back
+		suite.compare("to<vector>" + suffix, n,
+			[&] {
+				auto const v{ to<std::vector<int>>(source()) };
+
+				bench::do_not_optimize(v.data());
+			},
+			[&] {
+				std::vector<int> v;
+				auto r{ source() };
+
+				if constexpr (std::ranges::sized_range<R>)
+				{
+					v.reserve(std::ranges::size(r));
+				}
+
+				for (auto e : r)
+				{
+					v.push_back(e);
+				}
+
+				bench::do_not_optimize(v.data());
+			});
+
+		if constexpr (std::ranges::forward_range<R>)
+		{
+			//Over a vector this row has measured anywhere from 0.9x to 2.2x between builds of the same code: both sides
+			//compile to the same loop of one wrap check and one count, so the spread is code placement, not the view
+			suite.compare("cycle | take(2n)" + suffix, 2 * n,
+				[&] {
+					long long sum{ 0 };
+
+					for (auto e : source() | views::cycle | std::views::take(2 * n))
+					{
+						sum += e;
+					}
+
+					bench::do_not_optimize(sum);
+				},
+				[&] {
+					long long sum{ 0 };
+					auto r{ source() };
+					auto it{ std::ranges::begin(r) };
+
+					for (std::size_t i{ 0 }; i < 2 * n; ++i)
+					{
+						sum += *it;
+
+						if (++it == std::ranges::end(r))
+						{
+							it = std::ranges::begin(r);
+						}
+					}
+
+					bench::do_not_optimize(sum);
+				});
+
+			std::vector<int> const factors{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+			//Known slow, about 1.3x to 2x: the nested loop's inner loop over factors vectorizes, while the flat
+			//iterator checks for a carry on every step; cartesian_for_each is the way to get the nested loops back
+			suite.compare("cartesian_product(_, 8)" + suffix, n * std::size(factors),
+				[&] {
+					long long sum{ 0 };
+
+					for (auto const [x, y] : views::cartesian_product(source(), factors))
+					{
+						sum += static_cast<long long>(x) * y;
+					}
+
+					bench::do_not_optimize(sum);
+				},
+				[&] {
+					long long sum{ 0 };
+
+					for (auto x : source())
+					{
+						for (auto y : factors)
+						{
+							sum += static_cast<long long>(x) * y;
+						}
+					}
+
+					bench::do_not_optimize(sum);
+				});
+		}
+	}
+
+	template <typename C>
+	void cycle_benchmarks(bench::comparison_suite& suite, std::string const& container, C const& c, std::size_t n)
+	{
+		//Same two loops as cycle | take(2n) in coverage_benchmarks, with the same spread over a vector
+		suite.compare("cycle | take " + container, n,
+			[&] {
+				long long sum{ 0 };
+
+				for (auto e : c | views::cycle | std::views::take(n))
+				{
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				auto it{ std::begin(c) };
+
+				for (std::size_t i{ 0 }; i < n; ++i)
+				{
+					sum += *it;
+
+					if (++it == std::end(c))
+					{
+						it = std::begin(c);
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	template <typename C>
+	void stride_benchmarks(bench::comparison_suite& suite, std::string const& container, C const& c, std::ptrdiff_t stride)
+	{
+		suite.compare("stride(" + std::to_string(stride) + ") " + container, std::size(c) / stride,
+			[&] {
+				long long sum{ 0 };
+
+				for (auto e : c | views::stride(stride))
+				{
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+
+				for (auto it{ std::begin(c) }; it != std::end(c); std::ranges::advance(it, stride, std::end(c)))
+				{
+					sum += *it;
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//Extracting one channel of interleaved samples: to<> over a stride of a contiguous buffer takes the bulk gather path
+	void stride_gather_benchmarks(bench::comparison_suite& suite, std::vector<int> const& samples, std::ptrdiff_t channels)
+	{
+		auto const frames{ (std::size(samples) + channels - 1) / channels };
+
+		suite.compare("to<vector>(stride(" + std::to_string(channels) + ")) vector", frames,
+			[&] {
+				auto const channel{ to<std::vector<int>>(samples | views::stride(channels)) };
+
+				bench::do_not_optimize(channel.data());
+			},
+			[&] {
+				std::vector<int> channel;
+
+				channel.reserve(frames);
+
+				for (std::size_t i{ 0 }; i < std::size(samples); i += channels)
+				{
+					channel.push_back(samples[i]);
+				}
+
+				bench::do_not_optimize(channel.data());
+			});
+	}
+
+	//Column-major reduction of a row-major matrix through strided_nd columns against indexing by hand
+	void strided_nd_benchmarks(bench::comparison_suite& suite, std::size_t rows, std::size_t columns)
+	{
+		std::vector<int> matrix(rows * columns);
+		std::iota(std::begin(matrix), std::end(matrix), 0);
+
+		auto const m{ views::strided_nd(matrix, { rows, columns }) };
+
+		//Known slow and noisy, from 0.9x to 1.7x between runs of the same build: every step down a column lands on a
+		//new cache line, so both sides wait on memory and the ratio swings with it
+		suite.compare("strided_nd columns", std::size(matrix),
+			[&] {
+				long long sum{ 0 };
+
+				for (std::size_t j{ 0 }; j < columns; ++j)
+				{
+					for (auto e : m.column(j))
+					{
+						sum += e;
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+
+				for (std::size_t j{ 0 }; j < columns; ++j)
+				{
+					for (std::size_t i{ 0 }; i < rows; ++i)
+					{
+						sum += matrix[i * columns + j];
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//Transpose by copying into a column-major view of the output, tile by tile against row-major order
+	//Row-major order writes one element per cache line of the output and moves on, so once the matrix is larger than
+	//the cache every line is fetched again for each of its elements; a tile reuses its lines before they are evicted
+	void strided_nd_tiles_benchmarks(bench::comparison_suite& suite, std::size_t side, std::size_t tile_side)
+	{
+		std::vector<int> matrix(side * side), transposed(side * side);
+		std::iota(std::begin(matrix), std::end(matrix), 0);
+
+		auto const from{ views::strided_nd(matrix, { side, side }) };
+		auto const to{ views::strided_nd(transposed, std::array{ side, side }, std::array<std::ptrdiff_t, 2>{ 1, static_cast<std::ptrdiff_t>(side) }) };
+
+		suite.compare("strided_nd tiles transpose " + std::to_string(side) + "x" + std::to_string(side), std::size(matrix), 0.9,
+			[&] {
+				auto const from_tiles{ from.tiles({ tile_side, tile_side }) };
+				auto const to_tiles{ to.tiles({ tile_side, tile_side }) };
+
+				for (std::size_t t{ 0 }; t < std::size(from_tiles); ++t)
+				{
+					auto const to_tile{ to_tiles[t] };
+
+					std::ranges::copy(from_tiles[t], std::ranges::begin(to_tile));
+				}
+
+				bench::do_not_optimize(transposed.data());
+			},
+			[&] {
+				std::ranges::copy(from, std::ranges::begin(to));
+				bench::do_not_optimize(transposed.data());
+			});
+	}
+
+	//Running totals through the lazy scan against a hand-kept running sum
+	void scan_benchmarks(bench::comparison_suite& suite, std::vector<int> const& v)
+	{
+		suite.compare("inclusive_scan vector", std::size(v),
+			[&] {
+				long long sum{ 0 };
+
+				for (auto e : v | views::inclusive_scan())
+				{
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				int running{ 0 };
+
+				for (auto e : v)
+				{
+					running += e;
+					sum += running;
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//Moving sum over a telemetry-sized stream: the O(1) window reducer against a running sum kept by hand
+	void sliding_sum_benchmarks(bench::comparison_suite& suite, std::vector<int> const& v, std::ptrdiff_t window)
+	{
+		suite.compare("sliding_sum(" + std::to_string(window) + ") vector", std::size(v),
+			[&] {
+				long long sum{ 0 };
+
+				for (auto e : v | views::sliding_sum(window))
+				{
+					sum += e;
+				}
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+				int running{ 0 };
+
+				for (std::size_t i{ 0 }; i < std::size(v); ++i)
+				{
+					running += v[i];
+
+					if (i + 1 >= static_cast<std::size_t>(window))
+					{
+						sum += running;
+						running -= v[i + 1 - window];
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//enumerate_for_each has to compile to the same vectorized loop as indexing by hand;
+	//if it falls back to a scalar loop the ratio jumps well past the tolerance
+	void enumerate_benchmarks(bench::comparison_suite& suite, std::vector<int> const& v)
+	{
+		suite.compare("enumerate_for_each vector", std::size(v),
+			[&] {
+				long long sum{ 0 };
+
+				enumerate_for_each(v, [&](std::size_t i, int e) { sum += static_cast<long long>(i) * e; });
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				long long sum{ 0 };
+
+				for (std::size_t i{ 0 }; i < std::size(v); ++i)
+				{
+					sum += static_cast<long long>(i) * v[i];
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//Grid evaluation through the push-based cartesian_for_each against hand-written nested loops
+	//The reduction is over unsigned ints so that the innermost loop of both can vectorize; a float sum could not
+	//be reordered without -ffast-math and would only measure the latency of one add chain
+	void cartesian_for_each_benchmarks(bench::comparison_suite& suite, std::size_t side)
+	{
+		std::vector<std::uint32_t> xs(side), ys(side), zs(side);
+		std::iota(std::begin(xs), std::end(xs), 0u);
+		std::iota(std::begin(ys), std::end(ys), 0u);
+		std::iota(std::begin(zs), std::end(zs), 0u);
+
+		suite.compare("cartesian_for_each " + std::to_string(side) + "^3", side * side * side,
+			[&] {
+				std::uint32_t sum{ 0 };
+
+				cartesian_for_each([&](std::uint32_t x, std::uint32_t y, std::uint32_t z) { sum += x * y - z; }, xs, ys, zs);
+
+				bench::do_not_optimize(sum);
+			},
+			[&] {
+				std::uint32_t sum{ 0 };
+
+				for (auto x : xs)
+				{
+					for (auto y : ys)
+					{
+						for (auto z : zs)
+						{
+							sum += x * y - z;
+						}
+					}
+				}
+
+				bench::do_not_optimize(sum);
+			});
+	}
+
+	//Nearest-pair search over two point sets, tile by tile against lexicographic order
+	//Tiling pays off only here, where the inner points do not fit in L2 and every outer point reads all of them again,
+	//while the distance is cheap enough that memory is the limit. With an inner range that fits in cache, or a
+	//per-pair cost that dwarfs the loads, tiling only adds tile bookkeeping and is slower than the plain product
+	template <std::size_t Dimensions>
+	void tiled_cartesian_benchmarks(bench::comparison_suite& suite, std::size_t outer, std::size_t inner)
+	{
+		using point = std::array<std::int32_t, Dimensions>;
+
+		std::vector<point> xs(outer), ys(inner);
+		std::int32_t next{ 0 };
+
+		for (auto& p : xs)
+		{
+			std::ranges::generate(p, [&] { return next++ * 7919 % 1000; });
+		}
+
+		for (auto& p : ys)
+		{
+			std::ranges::generate(p, [&] { return next++ * 7919 % 1000; });
+		}
+
+		auto const nearest_pair{ [](auto const& product) {
+			auto nearest{ std::numeric_limits<std::int32_t>::max() };
+
+			for (auto const [x, y] : product)
+			{
+				std::int32_t distance{ 0 };
+
+				for (std::size_t i{ 0 }; i < Dimensions; ++i)
+				{
+					distance += (x[i] - y[i]) * (x[i] - y[i]);
+				}
+
+				nearest = std::min(nearest, distance);
+			}
+
+			bench::do_not_optimize(nearest);
+		} };
+
+		suite.compare("tiled_cartesian_product distances " + std::to_string(outer) + "x" + std::to_string(inner), outer * inner, 0.9,
+			[&] { nearest_pair(views::tiled_cartesian_product(xs, ys)); },
+			[&] { nearest_pair(views::cartesian_product(xs, ys)); });
+	}
+
+	//Equi-join through a hash table against filtering every pair of the cartesian product
+	void hash_join_benchmarks(bench::comparison_suite& suite, std::size_t n)
+	{
+		std::vector<int> a(n), b(n);
+		std::iota(std::begin(a), std::end(a), 0);
+		std::transform(std::begin(a), std::end(a), std::begin(b), [n](int i) { return static_cast<int>((i * 7) % n); });
+
+		auto const join{ [](auto&& pairs) {
+			long long sum{ 0 };
+
+			for (auto const [x, y] : pairs)
+			{
+				sum += x + y;
+			}
+
+			bench::do_not_optimize(sum);
+		} };
+
+		suite.compare("hash_join " + std::to_string(n) + "x" + std::to_string(n), n * n,
+			[&] { join(views::hash_join(a, b, std::identity{}, std::identity{})); },
+			[&] { join(views::cartesian_product(a, b) | std::views::filter([](auto const& t) { return std::get<0>(t) == std::get<1>(t); })); });
+	}
+
+	//Reduces a cartesian product with a growing number of threads and reports the speedup over one thread
+	void cartesian_scaling_benchmarks(std::size_t side)
+	{
+		std::vector<long long> v(side);
+		std::iota(std::begin(v), std::end(v), 0);
+
+		auto const product{ views::cartesian_product(v, v, v) };
+		auto const elements{ product.size() };
+		auto const max_threads{ std::max(1u, std::thread::hardware_concurrency()) };
+
+		double single_ns{ 0 };
+
+		for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2)
+		{
+			auto const ns{ bench::measure(elements, [&] {
+				auto const sum{ parallel_reduce(product, 0LL, std::plus<>{}, [](auto const& e) {
+					auto const& [x, y, z] { e };
+					return x * y + z;
+				}, threads) };
+
+				bench::do_not_optimize(sum);
+			}) };
+
+			single_ns = threads == 1 ? ns : single_ns;
+
+			std::cout << "parallel_reduce cartesian_product " << std::setw(3) << threads << " threads"
+				<< std::fixed << std::setprecision(3) << std::setw(10) << ns << " ns/elem"
+				<< std::setw(8) << single_ns / ns << "x speedup\n";
+		}
+	}
+
+	//Offset-table sized prefix sum, two passes per block against std::inclusive_scan on one thread
+	void scan_scaling_benchmarks(std::size_t count)
+	{
+		std::vector<long long> v(count);
+		std::iota(std::begin(v), std::end(v), 0);
+		std::vector<long long> out(count);
+
+		auto const max_threads{ std::max(1u, std::thread::hardware_concurrency()) };
+		auto const serial_ns{ bench::measure(count, [&] {
+			std::inclusive_scan(std::begin(v), std::end(v), std::begin(out));
+			bench::do_not_optimize(out.data());
+		}) };
+
+		for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2)
+		{
+			auto const ns{ bench::measure(count, [&] {
+				parallel_inclusive_scan(v, std::begin(out), std::plus<>{}, threads);
+				bench::do_not_optimize(out.data());
+			}) };
+
+			std::cout << "parallel_inclusive_scan " << std::setw(3) << threads << " threads"
+				<< std::fixed << std::setprecision(3) << std::setw(10) << ns << " ns/elem"
+				<< std::setw(8) << serial_ns / ns << "x speedup\n";
+		}
+	}
+
+	//Every comparison the suite judges, in the order they are reported
+	void comparison_benchmarks(bench::comparison_suite& suite)
+	{
+		for (std::size_t const n : { 1 << 8, 1 << 12, 1 << 16 })
+		{
+			std::vector<int> v(n);
+			std::iota(std::begin(v), std::end(v), 0);
+			std::list<int> const l(std::begin(v), std::end(v));
+
+			coverage_benchmarks(suite, "vector", n, [&] { return std::views::all(v); });
+			coverage_benchmarks(suite, "list", n, [&] { return std::views::all(l); });
+			coverage_benchmarks(suite, "generator", n, [n] { return iota_generator(static_cast<int>(n)); });
+		}
+
+		std::vector<int> v(1 << 16);
+		std::iota(std::begin(v), std::end(v), 0);
+		std::list<int> const l(std::begin(v), std::end(v));
+
+		cycle_benchmarks(suite, "vector", v, 1 << 20);
+		cycle_benchmarks(suite, "list", l, 1 << 20);
+		stride_benchmarks(suite, "vector", v, 3);
+		stride_benchmarks(suite, "list", l, 3);
+		enumerate_benchmarks(suite, v);
+		scan_benchmarks(suite, v);
+		sliding_sum_benchmarks(suite, v, 64);
+
+		std::vector<int> samples(1 << 22);
+		std::iota(std::begin(samples), std::end(samples), 0);
+
+		stride_gather_benchmarks(suite, samples, 2);
+		stride_gather_benchmarks(suite, samples, 8);
+		stride_gather_benchmarks(suite, samples, 64);
+		strided_nd_benchmarks(suite, 512, 512);
+		//16MiB, far more than L2
+		strided_nd_tiles_benchmarks(suite, 2048, 32);
+		cartesian_for_each_benchmarks(suite, 128);
+		//128 points against 16384 points of 64 ints, 4MiB of inner points
+		tiled_cartesian_benchmarks<64>(suite, 128, 1 << 14);
+		hash_join_benchmarks(suite, 2000);
+	}
+}
+
+//benchmark [tolerance] [--baseline file] [--write-baseline file] [--margin factor] [--max-growth ratio] [--runs count]
+int main(int argc, char* argv[])
+{
+	//Allowed slowdown of a view against its hand-written loop before the run fails, for views without a baseline
+	auto tolerance{ 1.5 };
+	//Allowed growth of a ratio over its baseline before the run fails, wide enough for a busy machine
+	auto margin{ 1.5 };
+	//Cap on that growth, so that rows which are slow to begin with do not get a proportionally wider allowance
+	auto max_growth{ 0.5 };
+	//Times the comparisons are repeated; a baseline written after several runs keeps the slowest ratio of each row
+	auto runs{ 1 };
+	char const* baseline_path{ nullptr };
+	char const* write_baseline_path{ nullptr };
+
+	for (auto i{ 1 }; i < argc; ++i)
+	{
+		std::string_view const arg{ argv[i] };
+
+		if (arg == "--baseline" && i + 1 < argc)
+		{
+			baseline_path = argv[++i];
+		}
+		else if (arg == "--write-baseline" && i + 1 < argc)
+		{
+			write_baseline_path = argv[++i];
+		}
+		else if (arg == "--margin" && i + 1 < argc)
+		{
+			margin = std::atof(argv[++i]);
+		}
+		else if (arg == "--max-growth" && i + 1 < argc)
+		{
+			max_growth = std::atof(argv[++i]);
+		}
+		else if (arg == "--runs" && i + 1 < argc)
+		{
+			runs = std::max(1, std::atoi(argv[++i]));
+		}
+		else
+		{
+			tolerance = std::atof(argv[i]);
+		}
+	}
+
+	bench::comparison_suite suite{ tolerance, margin, max_growth };
+
+	if (baseline_path)
+	{
+		std::ifstream in{ baseline_path };
+
+		if (!in)
+		{
+			std::cerr << "cannot read baseline " << baseline_path << '\n';
+
+			return EXIT_FAILURE;
+		}
+
+		suite.use_baseline(bench::read_baseline(in));
+	}
+
+	for (auto run{ 0 }; run < runs; ++run)
+	{
+		if (runs > 1)
+		{
+			std::cout << "run " << run + 1 << " of " << runs << '\n';
+		}
+
+		comparison_benchmarks(suite);
+	}
+
+	cartesian_scaling_benchmarks(256);
+	scan_scaling_benchmarks(1 << 24);
+
+	if (write_baseline_path)
+	{
+		std::ofstream out{ write_baseline_path };
+
+		suite.write_baseline(out);
+	}
+
+	return suite.failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
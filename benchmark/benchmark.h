@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+	//Keep the compiler from optimizing away a computed value
+	template <typename T>
+	inline void do_not_optimize(T const& value)
+	{
+#ifdef _MSC_VER
+		static_cast<void>(*static_cast<volatile char const*>(static_cast<void const*>(&value)));
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	inline constexpr std::chrono::milliseconds min_run_time{ 20 };
+	inline constexpr auto runs{ 5 };
+
+	//ns per element over one run, long enough to swamp the clock resolution
+	template <typename F>
+	double run_once(std::size_t elements, F&& f)
+	{
+		using clock = std::chrono::steady_clock;
+
+		std::size_t iterations{ 0 };
+		auto const start{ clock::now() };
+		auto elapsed{ clock::duration{} };
+
+		do
+		{
+			f();
+			++iterations;
+			elapsed = clock::now() - start;
+		} while (elapsed < min_run_time);
+
+		auto const ns{ std::chrono::duration<double, std::nano>(elapsed).count() };
+
+		return ns / static_cast<double>(iterations * std::max<std::size_t>(elements, 1));
+	}
+
+	//Best of several runs
+	template <typename F>
+	double measure(std::size_t elements, F&& f)
+	{
+		auto best{ std::numeric_limits<double>::max() };
+
+		for (auto run{ 0 }; run < runs; ++run)
+		{
+			best = std::min(best, run_once(elements, f));
+		}
+
+		return best;
+	}
+
+	//Best of several runs of each, taken in turns so a machine that slows down for a while slows down both
+	template <typename F, typename G>
+	std::pair<double, double> measure_pair(std::size_t elements, F&& f, G&& g)
+	{
+		auto best{ std::make_pair(std::numeric_limits<double>::max(), std::numeric_limits<double>::max()) };
+
+		for (auto run{ 0 }; run < runs; ++run)
+		{
+			best.first = std::min(best.first, run_once(elements, f));
+			best.second = std::min(best.second, run_once(elements, g));
+		}
+
+		return best;
+	}
+
+	//Calls to the global operator new, counted by the replacement in benchmark.cpp
+	inline std::atomic<std::size_t> allocation_count{ 0 };
+
+	//Allocations made by a single call of f
+	template <typename F>
+	std::size_t count_allocations(F&& f)
+	{
+		auto const before{ allocation_count.load(std::memory_order_relaxed) };
+
+		f();
+
+		return allocation_count.load(std::memory_order_relaxed) - before;
+	}
+
+	//Cache misses of this thread as counted by the hardware, read through perf events on Linux
+	//Elsewhere, or when the kernel refuses the counter (see perf_event_paranoid), there is nothing to read
+	class cache_miss_counter
+	{
+	public:
+		cache_miss_counter()
+		{
+#ifdef __linux__
+			perf_event_attr attr{};
+
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+
+			fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+
+		~cache_miss_counter()
+		{
+#ifdef __linux__
+			if (fd_ >= 0)
+			{
+				close(fd_);
+			}
+#endif
+		}
+
+		cache_miss_counter(cache_miss_counter const&) = delete;
+		cache_miss_counter& operator=(cache_miss_counter const&) = delete;
+
+		bool available() const
+		{
+			return fd_ >= 0;
+		}
+
+		//Misses per element over enough calls of f to fill one measurement run
+		template <typename F>
+		std::optional<double> measure(std::size_t elements, F&& f)
+		{
+#ifdef __linux__
+			if (available())
+			{
+				using clock = std::chrono::steady_clock;
+
+				std::size_t iterations{ 0 };
+				std::uint64_t misses{ 0 };
+				auto const start{ clock::now() };
+
+				ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+
+				do
+				{
+					f();
+					++iterations;
+				} while (clock::now() - start < min_run_time);
+
+				ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+
+				if (read(fd_, &misses, sizeof(misses)) == sizeof(misses))
+				{
+					return static_cast<double>(misses) / static_cast<double>(iterations * std::max<std::size_t>(elements, 1));
+				}
+			}
+#endif
+			static_cast<void>(elements);
+			static_cast<void>(f);
+
+			return std::nullopt;
+		}
+
+	private:
+		int fd_ = -1;
+	};
+
+	struct result
+	{
+		std::string name;
+		double view_ns;
+		double loop_ns;
+		double ratio;
+		std::size_t view_allocations;
+		std::size_t loop_allocations;
+	};
+
+	//What a comparison measured when it was last accepted; the ratio is stored rather than the time, so a baseline
+	//recorded on one machine still means something on another
+	struct baseline_entry
+	{
+		double ratio;
+		std::size_t allocations;
+	};
+
+	using baseline = std::map<std::string, baseline_entry, std::less<>>;
+
+	//One "name<TAB>ratio<TAB>allocations" line per comparison; lines starting with # are comments
+	inline baseline read_baseline(std::istream& in)
+	{
+		baseline entries;
+
+		for (std::string line; std::getline(in, line);)
+		{
+			if (line.empty() || line.front() == '#')
+			{
+				continue;
+			}
+
+			auto const tab{ line.find('\t') };
+			std::istringstream fields{ line.substr(tab == std::string::npos ? std::size(line) : tab) };
+			baseline_entry entry{};
+
+			if (fields >> entry.ratio >> entry.allocations)
+			{
+				entries.emplace(line.substr(0, tab), entry);
+			}
+		}
+
+		return entries;
+	}
+
+	//Compares a view pipeline against the equivalent hand-written loop
+	//A view without a baseline fails when it is more than tolerance times slower than its loop
+	//One with a baseline is held to its recorded ratio instead, whether that is below or above tolerance: it may grow
+	//by margin times, but never by more than max_growth, so a row recorded at 0.008x fails past 0.012x and one at
+	//2.3x past 2.8x; it also fails when it allocates more than it used to
+	//A view compared with a required ratio has to meet it, baseline or not
+	class comparison_suite
+	{
+	public:
+		explicit comparison_suite(double tolerance, double margin = 1.5, double max_growth = 0.5)
+			: tolerance_{ tolerance }, margin_{ margin }, max_growth_{ max_growth }
+		{
+
+		}
+
+		void use_baseline(baseline entries)
+		{
+			baseline_ = std::move(entries);
+		}
+
+		template <typename View, typename Loop>
+		void compare(std::string_view name, std::size_t elements, View&& view, Loop&& loop)
+		{
+			run(name, elements, std::nullopt, view, loop);
+		}
+
+		//For a view that exists to beat its loop: the ratio has to stay under required, whatever the baseline says
+		template <typename View, typename Loop>
+		void compare(std::string_view name, std::size_t elements, double required, View&& view, Loop&& loop)
+		{
+			run(name, elements, required, view, loop);
+		}
+
+		//Records every comparison in the format read_baseline reads
+		//A comparison that ran more than once is recorded with the slowest ratio and the most allocations it showed,
+		//so a baseline taken over several runs leaves room for the noise of each of them
+		void write_baseline(std::ostream& out) const
+		{
+			std::vector<std::pair<std::string_view, baseline_entry>> entries;
+
+			for (auto const& r : results_)
+			{
+				auto const entry{ std::ranges::find(entries, std::string_view{ r.name }, &std::pair<std::string_view, baseline_entry>::first) };
+
+				if (entry == std::end(entries))
+				{
+					entries.push_back({ r.name, { r.ratio, r.view_allocations } });
+				}
+				else
+				{
+					entry->second.ratio = std::max(entry->second.ratio, r.ratio);
+					entry->second.allocations = std::max(entry->second.allocations, r.view_allocations);
+				}
+			}
+
+			out << "# name\tview/loop time ratio\tview allocations per call\n";
+
+			for (auto const& [name, entry] : entries)
+			{
+				out << name << '\t' << std::defaultfloat << std::setprecision(4) << entry.ratio << '\t' << entry.allocations << '\n';
+			}
+		}
+
+		int failures() const
+		{
+			return failures_;
+		}
+
+	private:
+		template <typename View, typename Loop>
+		void run(std::string_view name, std::size_t elements, std::optional<double> required, View& view, Loop& loop)
+		{
+			if (results_.empty())
+			{
+				print_header();
+			}
+
+			auto const [view_ns, loop_ns] { measure_pair(elements, view, loop) };
+			auto const ratio{ view_ns / loop_ns };
+			auto const view_allocations{ count_allocations(view) };
+			auto const loop_allocations{ count_allocations(loop) };
+			auto const view_misses{ cache_misses_.measure(elements, view) };
+			auto const loop_misses{ cache_misses_.measure(elements, loop) };
+
+			auto const recorded{ baseline_.find(name) };
+			auto const has_baseline{ recorded != std::end(baseline_) };
+			auto const limit{ required ? *required : has_baseline ? allowed(recorded->second.ratio) : tolerance_ };
+			auto const slow{ ratio > limit };
+			auto const allocates{ has_baseline && view_allocations > recorded->second.allocations };
+
+			failures_ += slow || allocates ? 1 : 0;
+
+			std::cout << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(3)
+				<< std::setw(10) << view_ns << std::setw(10) << loop_ns << std::setw(8) << ratio << 'x'
+				<< std::setw(8) << limit << 'x'
+				<< std::setw(8) << view_allocations << std::setw(8) << loop_allocations
+				<< std::setw(10) << format_misses(view_misses) << std::setw(10) << format_misses(loop_misses)
+				<< (has_baseline ? "" : "  (no baseline)") << (slow ? "  SLOW" : "") << (allocates ? "  ALLOCATES" : "") << '\n';
+
+			results_.push_back({ std::string{ name }, view_ns, loop_ns, ratio, view_allocations, loop_allocations });
+		}
+
+		double allowed(double recorded) const
+		{
+			return std::min(recorded * margin_, recorded + max_growth_);
+		}
+
+		void print_header() const
+		{
+			std::cout << std::left << std::setw(44) << "ns/elem, allocations/call, cache misses/elem" << std::right
+				<< std::setw(10) << "view" << std::setw(10) << "loop" << std::setw(9) << "ratio" << std::setw(9) << "limit"
+				<< std::setw(8) << "view" << std::setw(8) << "loop" << std::setw(10) << "view" << std::setw(10) << "loop" << '\n';
+		}
+
+		static std::string format_misses(std::optional<double> misses)
+		{
+			if (!misses)
+			{
+				return "n/a";
+			}
+
+			std::ostringstream out;
+
+			out << std::fixed << std::setprecision(3) << *misses;
+
+			return out.str();
+		}
+
+		double tolerance_;
+		double margin_;
+		double max_growth_;
+		int failures_ = 0;
+		baseline baseline_;
+		std::vector<result> results_;
+		cache_miss_counter cache_misses_;
+	};
+}
\ No newline at end of file
@@ -121,7 +121,7 @@ public:
 			(void)this->operator++();
 		}
 
-		reference_type operator*() noexcept(noexcept(std::is_nothrow_copy_constructible_v<reference_type>))
+		reference_type operator*() const noexcept(noexcept(std::is_nothrow_copy_constructible_v<reference_type>))
 		{
 			return *handle_.promise().value_;
 		}
@@ -0,0 +1,427 @@
+#pragma once
+
+#include "common.h"
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//views::cartesian_product(v, v, ..., v) with the same range N times
+//The base is stored once and the iterator is just N indices into it instead of N copies of the base's iterators
+//views::cartesian_power<N>(r) yields std::tuples of N references; views::cartesian_power(r, n) picks the number
+//of factors at run time and yields a std::span over a buffer of n copied elements owned by the iterator
+//Both throw std::out_of_range when size()^N does not fit in a std::ptrdiff_t
+namespace detail
+{
+    template <typename T, std::size_t>
+    using repeat_t = T;
+
+    template <typename T, std::size_t... Is>
+    std::tuple<repeat_t<T, Is>...> repeat_tuple(std::index_sequence<Is...>);
+
+    //std::tuple of N Ts
+    template <typename T, std::size_t N>
+    using repeated_tuple_t = decltype(repeat_tuple<T>(std::make_index_sequence<N>{}));
+
+    //Checks that every position of the product, and the distance between any two, fits in a std::ptrdiff_t
+    constexpr void check_power_size(std::size_t size, std::size_t n)
+    {
+        constexpr auto max{ static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) };
+        std::size_t power{ 1 };
+
+        for (std::size_t d{ 0 }; d < n && power != 0; ++d)
+        {
+            if (size != 0 && power > max / size)
+            {
+                throw std::out_of_range("cartesian_power: size()^n does not fit in the difference type");
+            }
+
+            power *= size;
+        }
+    }
+}
+
+template <std::ranges::view V, std::size_t N>
+requires std::ranges::random_access_range<V> && std::ranges::sized_range<V> && (N > 0)
+class cartesian_power_view
+    : public std::ranges::view_interface<cartesian_power_view<V, N>>
+{
+    V base_;
+
+    template <bool Const>
+    class iterator
+    {
+        template<typename T>
+        using constify = std::conditional_t<Const, const T, T>;
+
+        //The view checked on construction that size()^N fits in a std::ptrdiff_t, so with two factors or more
+        //size() is below 2^32 and every index, the end's included, fits in 32 bits; positions are worked out in
+        //std::size_t
+        using index_type = std::conditional_t<(N > 1), std::uint32_t, std::size_t>;
+
+        constify<V>* base_ = nullptr;
+        //Lexicographic position, the end is { size, 0, ..., 0 }
+        std::array<index_type, N> indices_{};
+
+        constexpr index_type base_size() const
+        {
+            return static_cast<index_type>(std::ranges::size(*base_));
+        }
+
+        constexpr std::ptrdiff_t rank() const
+        {
+            std::size_t index{ 0 };
+
+            for (auto const i : indices_)
+            {
+                index = index * base_size() + i;
+            }
+
+            return static_cast<std::ptrdiff_t>(index);
+        }
+
+        constexpr void unrank(std::ptrdiff_t rank)
+        {
+            auto index{ static_cast<std::size_t>(rank) };
+
+            for (auto d{ N }; d-- > 1;)
+            {
+                indices_[d] = static_cast<index_type>(index % base_size());
+                index /= base_size();
+            }
+
+            indices_[0] = static_cast<index_type>(index);
+        }
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using reference = detail::repeated_tuple_t<std::ranges::range_reference_t<constify<V>>, N>;
+        using value_type = detail::repeated_tuple_t<std::ranges::range_value_t<constify<V>>, N>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr explicit iterator(begin_tag_t, constify<V>* base)
+            : base_{ base }
+        {
+
+        }
+
+        constexpr explicit iterator(end_tag_t, constify<V>* base)
+            : base_{ base }
+        {
+            indices_[0] = base_size();
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<V const>>
+            : base_{ i.base_ }, indices_{ i.indices_ }
+        {
+
+        }
+
+        constexpr auto operator*() const
+        {
+            auto const first{ std::ranges::begin(*base_) };
+
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return reference{ first[indices_[Is]]... };
+            }(std::make_index_sequence<N>{});
+        }
+
+        //Index into the base of the element at position d of the current tuple
+        constexpr index_type index(std::size_t d) const
+        {
+            return indices_[d];
+        }
+
+        constexpr iterator& operator++()
+        {
+            for (auto d{ N }; d-- > 1;)
+            {
+                if (++indices_[d] != base_size())
+                {
+                    return *this;
+                }
+
+                indices_[d] = 0;
+            }
+
+            ++indices_[0];
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator--()
+        {
+            for (auto d{ N }; d-- > 1;)
+            {
+                if (indices_[d]-- != 0)
+                {
+                    return *this;
+                }
+
+                indices_[d] = static_cast<index_type>(base_size() - 1);
+            }
+
+            --indices_[0];
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+        {
+            auto const temp{ *this };
+
+            --*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type n)
+        {
+            unrank(rank() + n);
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        constexpr auto operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        friend constexpr iterator operator+(iterator x, difference_type n)
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator+(difference_type n, iterator x)
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator-(iterator x, difference_type n)
+        {
+            return x -= n;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y)
+        {
+            return x.rank() - y.rank();
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.indices_ == y.indices_;
+        }
+
+        friend constexpr auto operator<=>(iterator const& x, iterator const& y)
+        {
+            return x.indices_ <=> y.indices_;
+        }
+
+        friend class iterator<!Const>;
+    };
+
+public:
+    cartesian_power_view() = default;
+
+    explicit cartesian_power_view(V base)
+        : base_{ std::move(base) }
+    {
+        detail::check_power_size(static_cast<std::size_t>(std::ranges::size(base_)), N);
+    }
+
+    constexpr auto begin()
+        requires (!simple_view<V>)
+    {
+        return iterator<false>(begin_tag, std::addressof(base_));
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::random_access_range<V const> && std::ranges::sized_range<V const>
+    {
+        return iterator<true>(begin_tag, std::addressof(base_));
+    }
+
+    constexpr auto end()
+        requires (!simple_view<V>)
+    {
+        return iterator<false>(end_tag, std::addressof(base_));
+    }
+
+    constexpr auto end() const
+        requires std::ranges::random_access_range<V const> && std::ranges::sized_range<V const>
+    {
+        return iterator<true>(end_tag, std::addressof(base_));
+    }
+
+    constexpr auto size() const
+        requires std::ranges::sized_range<V const>
+    {
+        auto const base_size{ std::ranges::size(base_) };
+        decltype(std::ranges::size(base_)) size{ 1 };
+
+        for (std::size_t d{ 0 }; d < N; ++d)
+        {
+            size *= base_size;
+        }
+
+        return size;
+    }
+};
+
+//Number of factors chosen at run time
+//The tuple is copied into a buffer owned by the iterator and only the elements that change are copied on
+//each increment; the std::span handed out is invalidated by the next increment, so this is an input range
+template <std::ranges::view V>
+requires std::ranges::random_access_range<V> && std::ranges::sized_range<V>
+class cartesian_power_view<V, std::dynamic_extent>
+    : public std::ranges::view_interface<cartesian_power_view<V, std::dynamic_extent>>
+{
+    V base_;
+    std::size_t n_ = 0;
+
+    class iterator
+    {
+        using value_buffer = std::vector<std::ranges::range_value_t<V const>>;
+        using index_type = std::ranges::range_difference_t<V const>;
+
+        V const* base_ = nullptr;
+        std::vector<index_type> indices_;
+        value_buffer values_;
+        bool done_ = true;
+
+        constexpr index_type base_size() const
+        {
+            return static_cast<index_type>(std::ranges::size(*base_));
+        }
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::span<typename value_buffer::value_type const>;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr iterator(V const* base, std::size_t n)
+            : base_{ base }, indices_(n), done_{ n != 0 && std::ranges::empty(*base) }
+        {
+            if (!done_ && n != 0)
+            {
+                values_.assign(n, *std::ranges::begin(*base_));
+            }
+        }
+
+        constexpr reference operator*() const
+        {
+            return values_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            auto const first{ std::ranges::begin(*base_) };
+
+            for (auto d{ indices_.size() }; d-- > 0;)
+            {
+                if (++indices_[d] != base_size())
+                {
+                    values_[d] = first[indices_[d]];
+
+                    return *this;
+                }
+
+                indices_[d] = 0;
+                values_[d] = first[0];
+            }
+
+            //Every index wrapped around, or there are no factors and the single empty tuple has been visited
+            done_ = true;
+
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.done_;
+        }
+    };
+
+public:
+    cartesian_power_view() = default;
+
+    cartesian_power_view(V base, std::size_t n)
+        : base_{ std::move(base) }, n_{ n }
+    {
+        detail::check_power_size(static_cast<std::size_t>(std::ranges::size(base_)), n_);
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::random_access_range<V const> && std::ranges::sized_range<V const>
+    {
+        return iterator{ std::addressof(base_), n_ };
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+
+    constexpr auto size() const
+        requires std::ranges::sized_range<V const>
+    {
+        auto const base_size{ std::ranges::size(base_) };
+        decltype(std::ranges::size(base_)) size{ 1 };
+
+        for (std::size_t d{ 0 }; d < n_; ++d)
+        {
+            size *= base_size;
+        }
+
+        return size;
+    }
+};
+
+namespace views
+{
+    template <std::size_t N, std::ranges::viewable_range R>
+    requires (N != std::dynamic_extent)
+    constexpr auto cartesian_power(R&& r)
+    {
+        return cartesian_power_view<std::views::all_t<R>, N>{ std::views::all(std::forward<R>(r)) };
+    }
+
+    template <std::ranges::viewable_range R>
+    constexpr auto cartesian_power(R&& r, std::size_t n)
+    {
+        return cartesian_power_view<std::views::all_t<R>, std::dynamic_extent>{ std::views::all(std::forward<R>(r)), n };
+    }
+}
@@ -0,0 +1,82 @@
+#include "cartesian_power.h"
+#include "cartesian_product.h"
+#include <catch.hpp>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("cartesian_power yields every tuple in lexicographic order")
+{
+	std::vector const a{ 1, 2, 3 };
+	auto const view{ views::cartesian_power<2>(a) };
+
+	REQUIRE(view.size() == 9);
+	REQUIRE(view.end() - view.begin() == 9);
+	REQUIRE(view.begin()[5] == std::tuple{ 2, 3 });
+	REQUIRE(*(view.end() - 1) == std::tuple{ 3, 3 });
+
+	auto last{ view.end() };
+
+	REQUIRE(*--last == std::tuple{ 3, 3 });
+	REQUIRE(*--last == std::tuple{ 3, 2 });
+}
+
+TEST_CASE("cartesian_power rejects a product that overflows the difference type")
+{
+	auto const base{ std::views::iota(0, 70000) };
+
+	REQUIRE_NOTHROW(views::cartesian_power<3>(base));
+	REQUIRE_THROWS_AS(views::cartesian_power<4>(base), std::out_of_range);
+	REQUIRE_THROWS_AS(views::cartesian_power(base, 4), std::out_of_range);
+	REQUIRE_THROWS_AS(views::cartesian_power<2>(std::views::iota(0LL, 1LL << 32)), std::out_of_range);
+}
+
+TEST_CASE("cartesian_power random access up to the largest product that fits")
+{
+	//3037000499^2 is just under 2^63
+	constexpr auto side{ 3037000499LL };
+	auto const view{ views::cartesian_power<2>(std::views::iota(0LL, side)) };
+	auto const size{ static_cast<std::ptrdiff_t>(view.size()) };
+
+	REQUIRE(view.end() - view.begin() == size);
+	REQUIRE(*(view.begin() + (size - 1)) == std::tuple{ side - 1, side - 1 });
+	REQUIRE(*(view.end() - side) == std::tuple{ side - 1, 0LL });
+	REQUIRE((view.begin() + side * 7 + 5).index(0) == 7);
+	REQUIRE((view.begin() + side * 7 + 5).index(1) == 5);
+}
+
+TEST_CASE("cartesian_power with no factors yields one empty tuple")
+{
+	std::vector const a{ 1, 2, 3 };
+	auto count{ 0 };
+
+	for (auto const t : views::cartesian_power(a, 0))
+	{
+		REQUIRE(t.empty());
+		++count;
+	}
+
+	REQUIRE(count == 1);
+}
+
+TEST_CASE("cartesian_power iterators are smaller than cartesian_product ones")
+{
+	std::string const s{ "abc" };
+	auto const square{ views::cartesian_power<2>(s) };
+	auto const cube{ views::cartesian_power<3>(s) };
+
+	STATIC_REQUIRE(sizeof(square.begin()) < sizeof(views::cartesian_product(s, s).begin()));
+	STATIC_REQUIRE(sizeof(cube.begin()) < sizeof(views::cartesian_product(s, s, s).begin()));
+
+	auto const product{ views::cartesian_product(s, s, s) };
+	auto it{ product.begin() };
+
+	for (auto const t : cube)
+	{
+		REQUIRE(t == *it++);
+	}
+
+	REQUIRE(it == product.end());
+}
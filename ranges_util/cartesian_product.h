@@ -1,10 +1,12 @@
 #pragma once
 
 #include "common.h"
+#include <functional>
 #include <iterator>
 #include <ranges>
 #include <type_traits>
 #include <tuple>
+#include <utility>
 
 
 namespace detail 
@@ -12,6 +14,44 @@ namespace detail
     template <typename... Ts>
     concept cartesian_product_is_common = (std::ranges::common_range<Ts> && ...)
         || ((std::ranges::random_access_range<Ts> && ...) && (std::ranges::sized_range<Ts> && ...));
+
+    //One real loop per range, passing the elements picked so far down as arguments
+    //The innermost loop indexes a pointer when its range is contiguous so the compiler can vectorize it
+    template <std::size_t N, typename F, typename Ranges, typename... Es>
+    constexpr void cartesian_for_each(F& f, Ranges const& ranges, Es&&... es)
+    {
+        if constexpr (N == std::tuple_size_v<Ranges>)
+        {
+            std::invoke(f, std::forward<Es>(es)...);
+        }
+        else if constexpr (N + 1 == std::tuple_size_v<Ranges> && std::ranges::contiguous_range<std::tuple_element_t<N, Ranges>>
+            && std::ranges::sized_range<std::tuple_element_t<N, Ranges>>)
+        {
+            auto* const data{ std::ranges::data(std::get<N>(ranges)) };
+            auto const size{ std::ranges::size(std::get<N>(ranges)) };
+
+            for (decltype(std::ranges::size(std::get<N>(ranges))) i{ 0 }; i < size; ++i)
+            {
+                std::invoke(f, es..., data[i]);
+            }
+        }
+        else
+        {
+            for (auto&& e : std::get<N>(ranges))
+            {
+                cartesian_for_each<N + 1>(f, ranges, es..., e);
+            }
+        }
+    }
+}
+
+//Calls f(a, b, ...) for every combination of elements, in the same order as cartesian_product_view,
+//but as nested loops instead of one flat iterator with a carry check on every increment
+template <std::ranges::forward_range... Rs, typename F>
+requires (sizeof...(Rs) > 0) && std::invocable<F&, std::ranges::range_reference_t<Rs>...>
+constexpr void cartesian_for_each(F f, Rs&&... rs)
+{
+    detail::cartesian_for_each<0>(f, std::forward_as_tuple(rs...));
 }
 
 template <std::ranges::forward_range... Ts>
@@ -41,7 +81,11 @@ class cartesian_product_view
         constexpr explicit iterator(begin_tag_t, constify<std::tuple<Ts...>>* bases)
             : bases_{ bases }, currents_{ std::apply([](auto&&... bs) { return std::make_tuple(std::ranges::begin(bs)...); }, *bases) }
         {
-
+            //An empty base anywhere makes the whole product empty
+            if (std::apply([](auto const&... bs) { return (std::ranges::empty(bs) || ...); }, *bases_))
+            {
+                std::ranges::advance(std::get<0>(currents_), std::ranges::end(std::get<0>(*bases_)));
+            }
         }
 
         constexpr explicit iterator(end_tag_t, constify<std::tuple<Ts...>>* bases)
@@ -111,10 +155,41 @@ class cartesian_product_view
             --it;
         }
 
+        //Linear index of the current tuple, treating the positions as digits with the bases' sizes as radices
+        template <std::size_t... Is>
+        constexpr difference_type rank(std::index_sequence<Is...>) const
+        {
+            difference_type index{ 0 };
+
+            ((index = index * static_cast<difference_type>(std::ranges::size(std::get<Is>(*bases_)))
+                + static_cast<difference_type>(std::get<Is>(currents_) - std::ranges::begin(std::get<Is>(*bases_)))), ...);
+
+            return index;
+        }
+
+        //Inverse of rank: jump straight to the tuple with the given linear index, one division per base
+        template <std::size_t N = (sizeof...(Ts) - 1)>
+        constexpr void unrank(difference_type index)
+        {
+            auto const& base{ std::get<N>(*bases_) };
+
+            if constexpr (N > 0)
+            {
+                auto const size{ static_cast<difference_type>(std::ranges::size(base)) };
+
+                std::get<N>(currents_) = std::ranges::begin(base) + index % size;
+                unrank<N - 1>(index / size);
+            }
+            else
+            {
+                std::get<N>(currents_) = std::ranges::begin(base) + index;
+            }
+        }
+
         template <std::size_t N = (sizeof...(Ts) - 1)>
         void advance(difference_type n)
         {
-            auto const& it{ std::get<N>(currents_) };
+            auto& it{ std::get<N>(currents_) };
             auto const& base{ std::get<N>(*bases_) };
             auto const begin{ std::ranges::begin(base) };
             auto const end{ std::ranges::end(base) };
@@ -229,6 +304,12 @@ class cartesian_product_view
             return iterator{ x } -= y;
         }
 
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y)
+            requires (std::ranges::random_access_range<constify<Ts>> && ...) && (std::ranges::sized_range<constify<Ts>> && ...)
+        {
+            return x.rank(std::index_sequence_for<Ts...>{}) - y.rank(std::index_sequence_for<Ts...>{});
+        }
+
         friend constexpr bool operator==(iterator const& x, iterator const& y)
             requires (std::equality_comparable < std::ranges::iterator_t<constify<Ts>>> && ...)
         {
@@ -272,6 +353,7 @@ class cartesian_product_view
 
         friend class sentinel;
         friend class iterator<!Const>;
+        friend class cartesian_product_view;
     };
 
 public:
@@ -311,12 +393,57 @@ public:
         return std::default_sentinel;
     }
 
+    //Push-based iteration, see cartesian_for_each
+    template <typename F>
+    constexpr void for_each(F f)
+        requires (!(simple_view<Ts> && ...))
+    {
+        std::apply([&](auto&... bases) { cartesian_for_each(std::move(f), bases...); }, bases_);
+    }
+
+    template <typename F>
+    constexpr void for_each(F f) const
+        requires (std::ranges::forward_range<const Ts> && ...)
+    {
+        std::apply([&](auto const&... bases) { cartesian_for_each(std::move(f), bases...); }, bases_);
+    }
+
+    //Tuple at the given linear index in lexicographic order, in O(number of bases)
+    //index must be less than size()
+    constexpr auto unrank(std::size_t index)
+        requires (!(simple_view<Ts> && ...)) && (std::ranges::random_access_range<Ts> && ...) && (std::ranges::sized_range<Ts> && ...)
+    {
+        auto it{ begin() };
+
+        it.unrank(static_cast<std::ptrdiff_t>(index));
+
+        return *it;
+    }
+
+    constexpr auto unrank(std::size_t index) const
+        requires (std::ranges::random_access_range<const Ts> && ...) && (std::ranges::sized_range<const Ts> && ...)
+    {
+        auto it{ begin() };
+
+        it.unrank(static_cast<std::ptrdiff_t>(index));
+
+        return *it;
+    }
+
+    //Linear index of the tuple an iterator points at, in O(number of bases)
+    template <bool Const>
+    constexpr std::size_t rank(iterator<Const> const& it) const
+        requires (std::ranges::random_access_range<const Ts> && ...) && (std::ranges::sized_range<const Ts> && ...)
+    {
+        return static_cast<std::size_t>(it.rank(std::index_sequence_for<Ts...>{}));
+    }
+
     constexpr auto size() requires (std::ranges::sized_range<Ts> && ...) 
     {
         return std::apply([](auto&&... bases) {
             using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
             return (static_cast<size_type>(std::ranges::size(bases)) * ...);
-            });
+            }, bases_);
     }
 
     constexpr auto size() const requires (std::ranges::sized_range<const Ts> && ...)
@@ -325,7 +452,7 @@ public:
         return std::apply([](auto&&... bases) {
             using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
             return (static_cast<size_type>(std::ranges::size(bases)) * ...);
-            });
+            }, bases_);
     }
 };
 
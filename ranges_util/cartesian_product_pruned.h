@@ -0,0 +1,203 @@
+#pragma once
+
+#include "common.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//Cartesian product that works as a backtracking search
+//pred is called with every prefix of a candidate tuple, i.e. pred(a), pred(a, b), ..., pred(a, b, ..., z),
+//and a rejected prefix skips every tuple that starts with it, so the inner ranges are never visited for it
+//The tuples produced are those whose every prefix was accepted, in lexicographic order
+//e.g. views::cartesian_product_pruned([](auto... p) { return (p + ... + 0) <= 3; }, v, v, v) over v = { 0, 1, 2, 3 }
+//only descends into b and c while a + b <= 3
+template <typename P, std::ranges::forward_range... Ts>
+requires (std::ranges::view<Ts> && ...) && (sizeof...(Ts) > 0) && std::is_object_v<P>
+class cartesian_product_pruned_view
+    : public std::ranges::view_interface<cartesian_product_pruned_view<P, Ts...>>
+{
+    std::tuple<Ts...> bases_;
+    P pred_;
+
+    template <bool Const>
+    class iterator
+    {
+        template<typename T>
+        using constify = std::conditional_t<Const, const T, T>;
+
+        constify<cartesian_product_pruned_view>* parent_ = nullptr;
+        std::tuple<std::ranges::iterator_t<constify<Ts>>...> currents_{};
+
+        template <std::size_t N>
+        constexpr auto& base() const
+        {
+            return std::get<N>(parent_->bases_);
+        }
+
+        template <std::size_t... Is>
+        constexpr bool accepts(std::index_sequence<Is...>) const
+        {
+            return std::invoke(parent_->pred_, *std::get<Is>(currents_)...);
+        }
+
+        //Starting from the current position of dimension N, find the first element whose prefix is accepted
+        //and whose subtree contains at least one accepted tuple
+        //Returns false if dimension N runs out, with the prefix before it unchanged
+        template <std::size_t N>
+        constexpr bool settle()
+        {
+            auto& it{ std::get<N>(currents_) };
+
+            for (; it != std::ranges::end(base<N>()); ++it)
+            {
+                if (!accepts(std::make_index_sequence<N + 1>{}))
+                {
+                    continue;
+                }
+
+                if constexpr (N + 1 == sizeof...(Ts))
+                {
+                    return true;
+                }
+                else
+                {
+                    std::get<N + 1>(currents_) = std::ranges::begin(base<N + 1>());
+
+                    if (settle<N + 1>())
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        //Step dimension N and search its remaining elements
+        //If dimension N runs out, carry into dimension N-1; dimension 0 running out is the end
+        template <std::size_t N = (sizeof...(Ts) - 1)>
+        constexpr void next()
+        {
+            ++std::get<N>(currents_);
+
+            if (settle<N>())
+            {
+                return;
+            }
+
+            if constexpr (N > 0)
+            {
+                next<N - 1>();
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<std::ranges::range_reference_t<constify<Ts>>...>;
+        using value_type = std::tuple<std::ranges::range_value_t<constify<Ts>>...>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr explicit iterator(begin_tag_t, constify<cartesian_product_pruned_view>* parent)
+            : parent_{ parent }
+        {
+            std::get<0>(currents_) = std::ranges::begin(base<0>());
+            settle<0>();
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && (std::convertible_to<std::ranges::iterator_t<Ts>, std::ranges::iterator_t<constify<Ts>>> && ...)
+            : parent_{ i.parent_ }, currents_{ std::move(i.currents_) }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return std::apply([](auto const&... currents) {
+                return reference{ *currents... };
+                }, currents_);
+        }
+
+        constexpr iterator& operator++()
+        {
+            next();
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            next();
+
+            return temp;
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+            requires (std::equality_comparable<std::ranges::iterator_t<constify<Ts>>> && ...)
+        {
+            return x.currents_ == y.currents_;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t const&)
+        {
+            return std::get<0>(x.currents_) == std::ranges::end(x.template base<0>());
+        }
+
+        friend class iterator<!Const>;
+    };
+
+public:
+    cartesian_product_pruned_view() = default;
+
+    explicit cartesian_product_pruned_view(P pred, Ts... bases)
+        : bases_(std::move(bases)...), pred_{ std::move(pred) }
+    {
+
+    }
+
+    constexpr auto begin()
+        requires (!(simple_view<Ts> && ...))
+    {
+        return iterator<false>(begin_tag, this);
+    }
+
+    constexpr auto begin() const
+        requires (std::ranges::forward_range<const Ts> && ...)
+    {
+        return iterator<true>(begin_tag, this);
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+};
+
+template <typename P, typename... Ts>
+cartesian_product_pruned_view(P, Ts&&...)->cartesian_product_pruned_view<P, std::views::all_t<Ts>...>;
+
+namespace views
+{
+    namespace detail
+    {
+        class cartesian_product_pruned_fn
+        {
+        public:
+            template <typename P, std::ranges::viewable_range... Ts>
+            constexpr auto operator()(P pred, Ts&&... ts) const
+            {
+                return cartesian_product_pruned_view{ std::move(pred), std::views::all(std::forward<Ts>(ts))... };
+            }
+        };
+    }
+
+    inline constexpr detail::cartesian_product_pruned_fn cartesian_product_pruned;
+}
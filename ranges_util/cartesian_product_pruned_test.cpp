@@ -0,0 +1,94 @@
+#include "cartesian_product_pruned.h"
+#include <algorithm>
+#include <array>
+#include <catch.hpp>
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("cartesian_product_pruned finds the six queens solutions")
+{
+	//Accept a prefix of columns if the queen placed last attacks none of the earlier ones
+	auto const safe{ [](auto... columns) {
+		std::array<int, sizeof...(columns)> const placed{ columns... };
+		auto const last{ placed.size() - 1 };
+
+		for (std::size_t row{ 0 }; row < last; ++row)
+		{
+			auto const distance{ static_cast<int>(last - row) };
+
+			if (placed[row] == placed[last] || placed[row] - placed[last] == distance || placed[last] - placed[row] == distance)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	} };
+
+	auto const columns{ std::views::iota(0, 6) };
+	std::vector<std::array<int, 6>> solutions;
+
+	for (auto const& solution : views::cartesian_product_pruned(safe, columns, columns, columns, columns, columns, columns))
+	{
+		solutions.push_back(std::apply([](auto... column) { return std::array<int, 6>{ column... }; }, solution));
+	}
+
+	REQUIRE(solutions == std::vector<std::array<int, 6>>{
+		{ 1, 3, 5, 0, 2, 4 }, { 2, 5, 1, 4, 0, 3 }, { 3, 0, 4, 1, 5, 2 }, { 4, 2, 0, 5, 3, 1 } });
+}
+
+TEST_CASE("cartesian_product_pruned never extends a rejected prefix")
+{
+	std::list const v{ 0, 1, 2, 3 };
+	std::vector<std::vector<int>> rejected;
+	auto extends_rejected{ false };
+
+	auto const small_sum{ [&](auto... p) {
+		std::vector<int> const prefix{ p... };
+
+		for (auto const& r : rejected)
+		{
+			extends_rejected = extends_rejected || (r.size() < prefix.size() && std::equal(r.begin(), r.end(), prefix.begin()));
+		}
+
+		if ((p + ... + 0) > 3)
+		{
+			rejected.push_back(prefix);
+
+			return false;
+		}
+
+		return true;
+	} };
+
+	std::vector<std::tuple<int, int, int>> tuples;
+
+	for (auto const& [a, b, c] : views::cartesian_product_pruned(small_sum, v, v, v))
+	{
+		tuples.emplace_back(a, b, c);
+	}
+
+	std::vector<std::tuple<int, int, int>> expected;
+
+	for (auto const a : v)
+	{
+		for (auto const b : v)
+		{
+			for (auto const c : v)
+			{
+				if (a + b + c <= 3)
+				{
+					expected.emplace_back(a, b, c);
+				}
+			}
+		}
+	}
+
+	REQUIRE(tuples == expected);
+	REQUIRE(tuples.size() == 20);
+	REQUIRE(!rejected.empty());
+	REQUIRE(!extends_rejected);
+}
@@ -0,0 +1,71 @@
+#include "cartesian_product.h"
+#include <catch.hpp>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("cartesian_product rank and unrank are inverse over a mixed-size product")
+{
+	std::vector const a{ 1, 2, 3 };
+	std::string const b{ "xy" };
+	std::vector const c{ 0.5, 1.5, 2.5, 3.5 };
+	auto const view{ views::cartesian_product(a, b, c) };
+	auto const size{ static_cast<std::ptrdiff_t>(view.size()) };
+
+	REQUIRE(size == 24);
+	REQUIRE(view.end() - view.begin() == size);
+	REQUIRE(view.begin() - view.end() == -size);
+
+	std::size_t position{ 0 };
+
+	for (auto it{ view.begin() }; it != view.end(); ++it, ++position)
+	{
+		REQUIRE(view.rank(it) == position);
+		REQUIRE(view.unrank(view.rank(it)) == *it);
+		REQUIRE(it - view.begin() == static_cast<std::ptrdiff_t>(position));
+		REQUIRE(view.end() - it == size - static_cast<std::ptrdiff_t>(position));
+		REQUIRE(view.begin() + static_cast<std::ptrdiff_t>(position) == it);
+	}
+
+	REQUIRE(position == view.size());
+	REQUIRE(view.unrank(13) == std::tuple{ 2, 'y', 1.5 });
+}
+
+TEST_CASE("cartesian_for_each calls f in the order of cartesian_product")
+{
+	std::vector const a{ 1, 2, 3 };
+	std::list const b{ 10, 20 };
+	std::vector const c{ 100, 200, 300, 400 };
+
+	auto const expected{ [](auto const& view) {
+		std::vector<std::tuple<int, int, int>> out;
+
+		for (auto const& [x, y, z] : view)
+		{
+			out.emplace_back(x, y, z);
+		}
+
+		return out;
+	} };
+
+	std::vector<std::tuple<int, int, int>> calls;
+	auto const record{ [&](int x, int y, int z) { calls.emplace_back(x, y, z); } };
+
+	//A contiguous innermost range takes the indexed loop, a list the range-for one
+	cartesian_for_each(record, a, b, c);
+	REQUIRE(calls == expected(views::cartesian_product(a, b, c)));
+
+	calls.clear();
+	cartesian_for_each(record, a, c, b);
+	REQUIRE(calls == expected(views::cartesian_product(a, c, b)));
+
+	calls.clear();
+	views::cartesian_product(c, a, b).for_each(record);
+	REQUIRE(calls == expected(views::cartesian_product(c, a, b)));
+
+	calls.clear();
+	cartesian_for_each(record, a, std::vector<int>{}, c);
+	REQUIRE(calls.empty());
+}
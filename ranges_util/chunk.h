@@ -0,0 +1,281 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+//Non-overlapping subranges of n elements, the last one shorter if the size is not a multiple of n
+//e.g. { 1, 2, 3, 4, 5 } | views::chunk(2) is { 1, 2 } { 3, 4 } { 5 }
+//n has to be positive; chunk_view throws std::out_of_range otherwise
+template <std::ranges::forward_range V>
+requires std::ranges::view<V>
+class chunk_view
+    : public std::ranges::view_interface<chunk_view<V>>
+{
+public:
+    chunk_view() = default;
+    chunk_view(V base, std::ranges::range_difference_t<V> n)
+        : base_(std::move(base)), n_(n)
+    {
+        if (n_ <= 0)
+        {
+            throw std::out_of_range("chunk_view: chunk size must be positive");
+        }
+    }
+
+    constexpr auto begin() requires (!simple_view<V>)
+    {
+        return iterator<false>(std::ranges::begin(base_), 0, n_, std::addressof(base_));
+    }
+
+    constexpr auto begin() const requires std::ranges::forward_range<const V>
+    {
+        return iterator<true>(std::ranges::begin(base_), 0, n_, std::addressof(base_));
+    }
+
+    constexpr auto end() requires (!simple_view<V>)
+    {
+        return end_of<false>(base_);
+    }
+
+    constexpr auto end() const requires std::ranges::forward_range<const V>
+    {
+        return end_of<true>(base_);
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V>
+    {
+        return (std::ranges::size(base_) + n_ - 1) / n_;
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<const V>
+    {
+        return (std::ranges::size(base_) + n_ - 1) / n_;
+    }
+
+    constexpr V base() const& requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+
+private:
+    V base_;
+    std::ranges::range_difference_t<V> n_ = 1;
+
+    template <bool Const>
+    class iterator
+    {
+        using Base = std::conditional_t<Const, const V, V>;
+
+        std::ranges::iterator_t<Base> current_{};
+        std::ranges::sentinel_t<Base> end_{};
+        //How far the last step fell short of n because it hit the end, so the end can step back onto the last chunk
+        std::ranges::range_difference_t<Base> missing_ = 0;
+        std::ranges::range_difference_t<Base> n_ = 1;
+
+    public:
+        using iterator_category = std::conditional_t<
+            std::ranges::random_access_range<Base>, std::random_access_iterator_tag, std::conditional_t<
+            std::ranges::bidirectional_range<Base>, std::bidirectional_iterator_tag, std::forward_iterator_tag>>;
+        using reference = std::ranges::subrange<std::ranges::iterator_t<Base>>;
+        using value_type = reference;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        constexpr explicit iterator(std::ranges::iterator_t<Base> current, difference_type missing, difference_type n, Base* base)
+            : current_{ std::move(current) }, end_{ std::ranges::end(*base) }, missing_{ missing }, n_{ n }
+        {
+
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
+            : current_{ std::move(i.current_) }, end_{ std::move(i.end_) }, missing_{ i.missing_ }, n_{ i.n_ }
+        {
+
+        }
+
+        constexpr std::ranges::iterator_t<Base> base() const
+        {
+            return current_;
+        }
+
+        constexpr value_type operator*() const
+        {
+            return { current_, std::ranges::next(current_, n_, end_) };
+        }
+
+        constexpr iterator& operator++()
+        {
+            missing_ = std::ranges::advance(current_, n_, end_);
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator--() requires std::ranges::bidirectional_range<Base>
+        {
+            std::ranges::advance(current_, missing_ - n_);
+            missing_ = 0;
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires std::ranges::bidirectional_range<Base>
+        {
+            auto temp{ *this };
+
+            --*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type x) requires std::ranges::random_access_range<Base>
+        {
+            if (x > 0)
+            {
+                missing_ = std::ranges::advance(current_, n_ * x, end_);
+            }
+            else if (x < 0)
+            {
+                std::ranges::advance(current_, n_ * x + missing_);
+                missing_ = 0;
+            }
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type x) requires std::ranges::random_access_range<Base>
+        {
+            return *this += -x;
+        }
+
+        constexpr value_type operator[](difference_type n) const requires std::ranges::random_access_range<Base>
+        {
+            return *(*this + n);
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.current_ == y.current_;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.current_ == x.end_;
+        }
+
+        friend constexpr auto operator<=>(iterator const& x, iterator const& y) requires std::ranges::random_access_range<Base> && std::three_way_comparable<std::ranges::iterator_t<Base>>
+        {
+            return x.current_ <=> y.current_;
+        }
+
+        friend constexpr iterator operator+(iterator x, difference_type y) requires std::ranges::random_access_range<Base>
+        {
+            return x += y;
+        }
+
+        friend constexpr iterator operator+(difference_type x, iterator y) requires std::ranges::random_access_range<Base>
+        {
+            return y += x;
+        }
+
+        friend constexpr iterator operator-(iterator x, difference_type y) requires std::ranges::random_access_range<Base>
+        {
+            return x -= y;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y) requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return (x.current_ - y.current_ + x.missing_ - y.missing_) / x.n_;
+        }
+
+        friend constexpr difference_type operator-(std::default_sentinel_t, iterator const& x) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return (x.end_ - x.current_ + x.n_ - 1) / x.n_;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, std::default_sentinel_t y) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return -(y - x);
+        }
+
+        friend class iterator<!Const>;
+    };
+
+    //A common end iterator of a bidirectional base has to know how short the last chunk is to step back,
+    //which takes the size; without it the end is a sentinel
+    template <bool Const, typename Base>
+    constexpr auto end_of(Base& base) const
+    {
+        if constexpr (std::ranges::common_range<Base> && std::ranges::sized_range<Base>)
+        {
+            auto const missing{ (n_ - static_cast<std::ranges::range_difference_t<Base>>(std::ranges::size(base)) % n_) % n_ };
+
+            return iterator<Const>(std::ranges::end(base), missing, n_, std::addressof(base));
+        }
+        else if constexpr (std::ranges::common_range<Base> && !std::ranges::bidirectional_range<Base>)
+        {
+            return iterator<Const>(std::ranges::end(base), 0, n_, std::addressof(base));
+        }
+        else
+        {
+            return std::default_sentinel;
+        }
+    }
+};
+
+template <class R>
+chunk_view(R&&, std::ranges::range_difference_t<R>)->chunk_view<std::views::all_t<R>>;
+
+namespace views
+{
+    namespace detail
+    {
+        template <std::integral D>
+        struct chunk_view_closure
+        {
+            D n_;
+
+            template <std::ranges::viewable_range V>
+            friend constexpr auto operator|(V&& v, chunk_view_closure const& clos)
+            {
+                return chunk_view{ std::forward<V>(v), clos.n_ };
+            }
+        };
+
+        class chunk_fn
+        {
+        public:
+            template <std::ranges::viewable_range V>
+            constexpr auto operator()(V&& v, std::ranges::range_difference_t<V> n) const
+            {
+                return chunk_view{ std::forward<V>(v), n };
+            }
+
+            template <std::integral D>
+            constexpr auto operator()(D n) const
+            {
+                return chunk_view_closure{ n };
+            }
+        };
+    }
+
+    inline constexpr detail::chunk_fn chunk;
+}
@@ -5,9 +5,11 @@
 #include <iterator>
 #include <algorithm>
 #include <functional>
+#include <optional>
 
-template <std::ranges::forward_range V, std::predicate<std::ranges::range_reference_t<V>, std::ranges::range_reference_t<V>> F>
+template <std::ranges::input_range V, std::predicate<std::ranges::range_reference_t<V>, std::ranges::range_reference_t<V>> F>
 class chunk_by_view
+	: public std::ranges::view_interface<chunk_by_view<V, F>>
 {
 public:
 	chunk_by_view() = default;
@@ -32,6 +34,17 @@ public:
 		return std::default_sentinel;
 	}
 
+	//Bidirectional common bases get an end iterator so the view can be walked backwards (e.g. std::views::reverse)
+	constexpr auto end() requires (!simple_view<V> && std::ranges::bidirectional_range<V> && std::ranges::common_range<V>)
+	{
+		return iterator<false>{ end_tag, std::ranges::end(base_), this };
+	}
+
+	constexpr auto end() const requires (std::ranges::bidirectional_range<V const> && std::ranges::common_range<V const>)
+	{
+		return iterator<true>{ end_tag, std::ranges::end(base_), this };
+	}
+
 	auto& base()
 	{
 		return base_;
@@ -58,9 +71,12 @@ private:
 		std::ranges::iterator_t<constify<V>> end_of_current_range;
 		constify<chunk_by_view>* parent;
 
-		using value_type = std::ranges::subrange<std::ranges::iterator_t<V>>;
+		//Groups of contiguous bases are std::span or std::basic_string_view
+		using value_type = detail::chunk_t<std::ranges::iterator_t<constify<V>>>;
+		using reference = value_type;
 		using pointer_type = std::add_pointer_t<value_type>;
-		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ranges::range_difference_t<constify<V>>;
+		using iterator_category = std::conditional_t<std::ranges::bidirectional_range<constify<V>>, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
 
 		void find_end_of_current_range()
 		{
@@ -69,6 +85,27 @@ private:
 			end_of_current_range = std::ranges::next(first_failed, 1, std::end(parent->base_));
 		}
 
+		//Walk backwards from the start of the current group until the predicate fails between two neighbours
+		void find_start_of_previous_range()
+		{
+			auto const first{ std::ranges::begin(parent->base_) };
+
+			end_of_current_range = current;
+			--current;
+
+			while (current != first)
+			{
+				auto const previous{ std::ranges::prev(current) };
+
+				if (!std::invoke(parent->func_, *previous, *current))
+				{
+					break;
+				}
+
+				current = previous;
+			}
+		}
+
 		iterator() = default;
 		constexpr iterator(std::ranges::iterator_t<constify<V>> current, constify<chunk_by_view>* parent)
 			: current{ std::move(current) }, parent(parent)
@@ -76,15 +113,21 @@ private:
 			find_end_of_current_range();
 		}
 
+		constexpr iterator(end_tag_t, std::ranges::iterator_t<constify<V>> end, constify<chunk_by_view>* parent)
+			: current{ end }, end_of_current_range{ std::move(end) }, parent(parent)
+		{
+
+		}
+
 		constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<V const>>
 			: current{ std::move(i.current) }, end_of_current_range{ std::move(i.end_of_current_range) }, parent(i.parent)
 		{
 
 		}
 
-		constexpr auto operator*()
+		constexpr auto operator*() const
 		{
-			return std::ranges::subrange{ current, end_of_current_range };
+			return detail::make_chunk(current, end_of_current_range);
 		}
 
 		constexpr iterator& operator++()
@@ -104,6 +147,22 @@ private:
 			return tmp;
 		}
 
+		constexpr iterator& operator--() requires std::ranges::bidirectional_range<constify<V>>
+		{
+			find_start_of_previous_range();
+
+			return *this;
+		}
+
+		constexpr iterator operator--(int) requires std::ranges::bidirectional_range<constify<V>>
+		{
+			auto tmp{ *this };
+
+			--*this;
+
+			return tmp;
+		}
+
 		friend constexpr bool operator==(iterator const& lhs, iterator const& rhs)
 		{
 			return lhs.current == rhs.current;
@@ -118,6 +177,146 @@ private:
 	};
 };
 
+//Single pass version for input ranges such as generators
+//Every group is an input range that shares the position of the outer iterator,
+//so begin() may only be called once and groups must be visited in order
+template <std::ranges::input_range V, std::predicate<std::ranges::range_reference_t<V>, std::ranges::range_reference_t<V>> F>
+requires (!std::ranges::forward_range<V>)
+class chunk_by_view<V, F>
+	: public std::ranges::view_interface<chunk_by_view<V, F>>
+{
+public:
+	chunk_by_view() = default;
+	chunk_by_view(V v, F f)
+		: base_{ std::move(v) }, func_{ std::move(f) }
+	{
+
+	}
+
+	constexpr auto begin()
+	{
+		current_.emplace(std::ranges::begin(base_));
+		end_of_current_range_ = *current_ == std::ranges::end(base_);
+
+		return outer_iterator{ this };
+	}
+
+	constexpr std::default_sentinel_t end() const
+	{
+		return std::default_sentinel;
+	}
+
+	auto& base()
+	{
+		return base_;
+	}
+
+	auto const& base() const
+	{
+		return base_;
+	}
+
+private:
+	V base_;
+	F func_;
+	std::optional<std::ranges::iterator_t<V>> current_;
+	//The predicate compares neighbours, so keep a copy of the element we just stepped over
+	std::optional<std::ranges::range_value_t<V>> previous_;
+	bool end_of_current_range_ = true;
+
+	constexpr void next_in_current_range()
+	{
+		previous_.emplace(**current_);
+		++*current_;
+		end_of_current_range_ = *current_ == std::ranges::end(base_) || !std::invoke(func_, *previous_, **current_);
+	}
+
+	struct inner_iterator
+	{
+		chunk_by_view* parent;
+
+		using value_type = std::ranges::range_value_t<V>;
+		using reference = std::ranges::range_reference_t<V>;
+		using difference_type = std::ranges::range_difference_t<V>;
+		using iterator_category = std::input_iterator_tag;
+
+		constexpr decltype(auto) operator*() const
+		{
+			return **parent->current_;
+		}
+
+		constexpr inner_iterator& operator++()
+		{
+			parent->next_in_current_range();
+
+			return *this;
+		}
+
+		constexpr void operator++(int)
+		{
+			++*this;
+		}
+
+		constexpr bool operator==(std::default_sentinel_t) const
+		{
+			return parent->end_of_current_range_;
+		}
+	};
+
+	struct group
+		: std::ranges::view_interface<group>
+	{
+		chunk_by_view* parent;
+
+		constexpr auto begin() const
+		{
+			return inner_iterator{ parent };
+		}
+
+		constexpr std::default_sentinel_t end() const
+		{
+			return std::default_sentinel;
+		}
+	};
+
+	struct outer_iterator
+	{
+		chunk_by_view* parent;
+
+		using value_type = group;
+		using difference_type = std::ranges::range_difference_t<V>;
+		using iterator_category = std::input_iterator_tag;
+
+		constexpr auto operator*() const
+		{
+			return group{ {}, parent };
+		}
+
+		//Skip whatever is left of the current group without materializing it
+		constexpr outer_iterator& operator++()
+		{
+			while (!parent->end_of_current_range_)
+			{
+				parent->next_in_current_range();
+			}
+
+			parent->end_of_current_range_ = *parent->current_ == std::ranges::end(parent->base_);
+
+			return *this;
+		}
+
+		constexpr void operator++(int)
+		{
+			++*this;
+		}
+
+		constexpr bool operator==(std::default_sentinel_t) const
+		{
+			return *parent->current_ == std::ranges::end(parent->base_);
+		}
+	};
+};
+
 template <typename R, typename F>
 chunk_by_view(R&&, F f)->chunk_by_view<std::views::all_t<R>, F>;
 
@@ -130,7 +329,7 @@ namespace views
 		{
 			F f;
 
-			template <std::ranges::forward_range R>
+			template <std::ranges::input_range R>
 			friend constexpr auto operator|(R&& r, chunk_by_closure&& c)
 			{
 				return chunk_by_view(std::forward<R>(r), std::move(c.f));
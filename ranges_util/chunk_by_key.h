@@ -4,9 +4,15 @@
 #include <ranges>
 #include <iterator>
 #include <utility>
+#include <algorithm>
+#include <functional>
+#include <optional>
 
-template <std::ranges::forward_range V, std::invocable<std::ranges::range_reference_t<V>> F>
+//When Sorted is true the base must be sorted by key (every key forms a single run),
+//which lets random access bases find the end of each run by galloping instead of a linear scan
+template <std::ranges::input_range V, std::invocable<std::ranges::range_reference_t<V>> F, bool Sorted = false>
 class chunk_by_key_view 
+    : public std::ranges::view_interface<chunk_by_key_view<V, F, Sorted>>
 {
 public:
     chunk_by_key_view() = default;
@@ -16,6 +22,12 @@ public:
 
     }
 
+    chunk_by_key_view(V v, F f, sorted_tag_t) requires Sorted
+        : base_{ std::move(v) }, func_{ std::move(f) }
+    {
+
+    }
+
     constexpr auto begin() requires (!simple_view<V>)
     {
         return iterator<false>{ std::ranges::begin(base_), this };
@@ -31,6 +43,17 @@ public:
         return std::default_sentinel;
     }
 
+    //Bidirectional common bases get an end iterator so the view can be walked backwards (e.g. std::views::reverse)
+    constexpr auto end() requires (!simple_view<V> && std::ranges::bidirectional_range<V> && std::ranges::common_range<V>)
+    {
+        return iterator<false>{ end_tag, std::ranges::end(base_), this };
+    }
+
+    constexpr auto end() const requires (std::ranges::bidirectional_range<V const> && std::ranges::common_range<V const>)
+    {
+        return iterator<true>{ end_tag, std::ranges::end(base_), this };
+    }
+
     auto& base()
     {
         return base_;
@@ -60,16 +83,70 @@ private:
         key_type current_key_;
         constify<chunk_by_key_view>* parent_;
 
-        using value_type = std::pair<key_type, std::ranges::subrange<std::ranges::iterator_t<V>>>;
+        //Groups of contiguous bases are std::span or std::basic_string_view
+        using value_type = std::pair<key_type, detail::chunk_t<std::ranges::iterator_t<constify<V>>>>;
+        using reference = value_type;
         using pointer_type = std::add_pointer_t<value_type>;
-        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ranges::range_difference_t<constify<V>>;
+        using iterator_category = std::conditional_t<std::ranges::bidirectional_range<constify<V>>, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
 
         void find_end_of_current_range() 
         {
             if (current_ != std::ranges::end(parent_->base_))
             {
                 current_key_ = std::invoke(parent_->func_, *current_);
-                end_of_current_range_ = std::find_if(current_, std::end(parent_->base_), [this](auto&& v) { return std::invoke(parent_->func_, v) != current_key_; });
+
+                if constexpr (Sorted && std::ranges::random_access_range<constify<V>>)
+                {
+                    gallop_to_end_of_current_range();
+                }
+                else
+                {
+                    end_of_current_range_ = std::find_if(current_, std::end(parent_->base_), [this](auto&& v) { return std::invoke(parent_->func_, v) != current_key_; });
+                }
+            }
+        }
+
+        //Probe current_ + 1, + 2, + 4, ... until the key changes, then binary search the last step
+        //This costs O(log(run length)) key evaluations per group
+        void gallop_to_end_of_current_range()
+        {
+            auto const last{ std::ranges::end(parent_->base_) };
+            auto const same_key{ [this](auto&& v) { return std::invoke(parent_->func_, v) == current_key_; } };
+            auto const remaining{ std::ranges::distance(current_, last) };
+            std::ranges::range_difference_t<constify<V>> low{ 1 };
+            std::ranges::range_difference_t<constify<V>> step{ 1 };
+
+            while (low + step <= remaining && same_key(current_[low + step - 1]))
+            {
+                low += step;
+                step *= 2;
+            }
+
+            auto const high{ std::min(low + step - 1, remaining) };
+
+            end_of_current_range_ = std::partition_point(current_ + low, current_ + high, same_key);
+        }
+
+        //Walk backwards from the start of the current group while the key stays the same
+        void find_start_of_previous_range()
+        {
+            auto const first{ std::ranges::begin(parent_->base_) };
+
+            end_of_current_range_ = current_;
+            --current_;
+            current_key_ = std::invoke(parent_->func_, *current_);
+
+            while (current_ != first)
+            {
+                auto const previous{ std::ranges::prev(current_) };
+
+                if (std::invoke(parent_->func_, *previous) != current_key_)
+                {
+                    break;
+                }
+
+                current_ = previous;
             }
         }
 
@@ -80,15 +157,21 @@ private:
             find_end_of_current_range();
         }
 
+        constexpr explicit iterator(end_tag_t, std::ranges::iterator_t<constify<V>> end, constify<chunk_by_key_view>* parent)
+            : current_{ end }, end_of_current_range_{ std::move(end) }, current_key_{}, parent_{ parent }
+        {
+
+        }
+
         constexpr iterator(iterator<!Const> i) requires Const&& std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<V const>>
-            : current_{ std::move(i.current_) }, end_of_current_range_{ std::move(i.end_of_current_range_) }, parent_(i.parent_)
+            : current_{ std::move(i.current_) }, end_of_current_range_{ std::move(i.end_of_current_range_) }, current_key_{ std::move(i.current_key_) }, parent_(i.parent_)
         {
 
         }
 
-        constexpr auto operator*() 
+        constexpr auto operator*() const
         {
-            return std::pair(current_key_, std::ranges::subrange{ current_, end_of_current_range_ });
+            return value_type{ current_key_, detail::make_chunk(current_, end_of_current_range_) };
         }
 
         constexpr iterator& operator++()
@@ -108,6 +191,22 @@ private:
             return tmp;
         }
 
+        constexpr iterator& operator--() requires std::ranges::bidirectional_range<constify<V>>
+        {
+            find_start_of_previous_range();
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires std::ranges::bidirectional_range<constify<V>>
+        {
+            auto tmp{ *this };
+
+            --*this;
+
+            return tmp;
+        }
+
         friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) 
         {
             return lhs.current_ == rhs.current_;
@@ -122,22 +221,194 @@ private:
     };
 };
 
+//Single pass version for input ranges such as generators
+//Every group is an input range that shares the position of the outer iterator,
+//so begin() may only be called once and groups must be visited in order
+template <std::ranges::input_range V, std::invocable<std::ranges::range_reference_t<V>> F, bool Sorted>
+requires (!std::ranges::forward_range<V>)
+class chunk_by_key_view<V, F, Sorted>
+    : public std::ranges::view_interface<chunk_by_key_view<V, F, Sorted>>
+{
+public:
+    chunk_by_key_view() = default;
+    chunk_by_key_view(V v, F f)
+        : base_{ std::move(v) }, func_{ std::move(f) }
+    {
+
+    }
+
+    chunk_by_key_view(V v, F f, sorted_tag_t) requires Sorted
+        : base_{ std::move(v) }, func_{ std::move(f) }
+    {
+
+    }
+
+    constexpr auto begin()
+    {
+        current_.emplace(std::ranges::begin(base_));
+        end_of_current_range_ = *current_ == std::ranges::end(base_);
+
+        if (!end_of_current_range_)
+        {
+            current_key_.emplace(std::invoke(func_, **current_));
+        }
+
+        return outer_iterator{ this };
+    }
+
+    constexpr std::default_sentinel_t end() const
+    {
+        return std::default_sentinel;
+    }
+
+    auto& base()
+    {
+        return base_;
+    }
+
+    auto const& base() const
+    {
+        return base_;
+    }
+
+private:
+    using key_type = std::invoke_result_t<F, std::ranges::range_reference_t<V>>;
+
+    V base_;
+    F func_;
+    std::optional<std::ranges::iterator_t<V>> current_;
+    std::optional<key_type> current_key_;
+    //Key of the first element of the next group, computed while looking for the end of the current one
+    std::optional<key_type> next_key_;
+    bool end_of_current_range_ = true;
+
+    constexpr void next_in_current_range()
+    {
+        ++*current_;
+
+        if (*current_ == std::ranges::end(base_))
+        {
+            end_of_current_range_ = true;
+        }
+        else if (auto key{ std::invoke(func_, **current_) }; key != *current_key_)
+        {
+            next_key_.emplace(std::move(key));
+            end_of_current_range_ = true;
+        }
+    }
+
+    struct inner_iterator
+    {
+        chunk_by_key_view* parent_;
+
+        using value_type = std::ranges::range_value_t<V>;
+        using reference = std::ranges::range_reference_t<V>;
+        using difference_type = std::ranges::range_difference_t<V>;
+        using iterator_category = std::input_iterator_tag;
+
+        constexpr decltype(auto) operator*() const
+        {
+            return **parent_->current_;
+        }
+
+        constexpr inner_iterator& operator++()
+        {
+            parent_->next_in_current_range();
+
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const
+        {
+            return parent_->end_of_current_range_;
+        }
+    };
+
+    struct group
+        : std::ranges::view_interface<group>
+    {
+        chunk_by_key_view* parent_;
+
+        constexpr auto begin() const
+        {
+            return inner_iterator{ parent_ };
+        }
+
+        constexpr std::default_sentinel_t end() const
+        {
+            return std::default_sentinel;
+        }
+    };
+
+    struct outer_iterator
+    {
+        chunk_by_key_view* parent_;
+
+        using value_type = std::pair<key_type, group>;
+        using difference_type = std::ranges::range_difference_t<V>;
+        using iterator_category = std::input_iterator_tag;
+
+        constexpr auto operator*() const
+        {
+            return value_type{ *parent_->current_key_, group{ {}, parent_ } };
+        }
+
+        //Skip whatever is left of the current group without materializing it
+        constexpr outer_iterator& operator++()
+        {
+            while (!parent_->end_of_current_range_)
+            {
+                parent_->next_in_current_range();
+            }
+
+            if (*parent_->current_ != std::ranges::end(parent_->base_))
+            {
+                parent_->current_key_ = std::move(parent_->next_key_);
+                parent_->end_of_current_range_ = false;
+            }
+
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        constexpr bool operator==(std::default_sentinel_t) const
+        {
+            return *parent_->current_ == std::ranges::end(parent_->base_);
+        }
+    };
+};
+
 template <class R, class F>
 chunk_by_key_view(R&&, F f)->chunk_by_key_view<std::views::all_t<R>, F>;
 
+template <class R, class F>
+chunk_by_key_view(R&&, F f, sorted_tag_t)->chunk_by_key_view<std::views::all_t<R>, F, true>;
+
 namespace views
 {
     namespace detail 
     {
-        template <class F>
+        template <class F, bool Sorted = false>
         struct chunk_by_key_closure 
         {
             F f;
 
-            template <std::ranges::forward_range R>
+            template <std::ranges::input_range R>
             friend constexpr auto operator|(R&& r, chunk_by_key_closure&& c) 
             {
-                return chunk_by_key_view(std::forward<R>(r), std::move(c.f));
+                if constexpr (Sorted)
+                    return chunk_by_key_view(std::forward<R>(r), std::move(c.f), sorted_tag);
+                else
+                    return chunk_by_key_view(std::forward<R>(r), std::move(c.f));
             }
         };
 
@@ -148,6 +419,12 @@ namespace views
             {
                 return chunk_by_key_closure<F>{ std::move(f) };
             }
+
+            template <class F>
+            constexpr auto operator()(F f, sorted_tag_t) const
+            {
+                return chunk_by_key_closure<F, true>{ std::move(f) };
+            }
         };
     }
 
@@ -0,0 +1,93 @@
+#include "chunk_by.h"
+#include "chunk_by_key.h"
+#include "split_by.h"
+#include <catch.hpp>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("chunk_by input range")
+{
+	std::istringstream in{ "1 1 2 3 3 3" };
+	std::vector<std::vector<int>> groups;
+
+	for (auto&& group : std::views::istream<int>(in) | views::chunk_by(std::equal_to<>{}))
+	{
+		auto& out{ groups.emplace_back() };
+
+		std::ranges::copy(group, std::back_inserter(out));
+	}
+
+	REQUIRE(groups == std::vector<std::vector<int>>{ { 1, 1 }, { 2 }, { 3, 3, 3 } });
+}
+
+TEST_CASE("chunk_by_key input range skipping groups")
+{
+	std::istringstream in{ "1 1 2 3 3 3 4" };
+	std::vector<int> keys;
+
+	for (auto&& [key, group] : std::views::istream<int>(in) | views::chunk_by_key([](auto e) { return e; }))
+	{
+		keys.push_back(key);
+	}
+
+	REQUIRE(keys == std::vector{ 1, 2, 3, 4 });
+}
+
+
+TEST_CASE("chunk_by contiguous groups")
+{
+	std::vector v{ 1, 1, 2 };
+	std::string const s{ "aab" };
+
+	for (auto&& group : v | views::chunk_by(std::equal_to<>{}))
+	{
+		STATIC_REQUIRE(std::same_as<std::remove_cvref_t<decltype(group)>, std::span<int>>);
+		REQUIRE(group.front() == group.back());
+	}
+
+	for (auto&& [key, group] : s | views::chunk_by_key([](char c) { return c; }))
+	{
+		STATIC_REQUIRE(std::same_as<std::remove_cvref_t<decltype(group)>, std::string_view>);
+		REQUIRE(group.find_first_not_of(key) == std::string_view::npos);
+	}
+}
+
+TEST_CASE("split_by")
+{
+	std::string const s{ " alpha, beta,,gamma " };
+	std::vector<std::string_view> tokens;
+
+	for (auto&& token : s | views::split_by(", "))
+	{
+		tokens.push_back(token);
+	}
+
+	REQUIRE(tokens == std::vector<std::string_view>{ "alpha", "beta", "gamma" });
+	REQUIRE(tokens.front().data() == s.data() + 1);
+}
+
+TEST_CASE("chunk_by reverse")
+{
+	std::vector v{ 1, 1, 2, 3, 3, 3 };
+	std::vector<std::size_t> sizes;
+
+	for (auto&& group : v | views::chunk_by(std::equal_to<>{}) | std::views::reverse)
+	{
+		sizes.push_back(group.size());
+	}
+
+	REQUIRE(sizes == std::vector<std::size_t>{ 3, 1, 2 });
+}
+
+TEST_CASE("chunk_by_key prev from end")
+{
+	std::list l{ 10, 11, 20, 30, 31 };
+	auto groups{ l | views::chunk_by_key([](auto e) { return e / 10; }) };
+	auto last{ std::ranges::prev(std::ranges::end(groups)) };
+
+	REQUIRE((*last).first == 3);
+	REQUIRE((*std::ranges::prev(last)).first == 2);
+	REQUIRE(std::ranges::next(last) == std::ranges::end(groups));
+}
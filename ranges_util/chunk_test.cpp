@@ -0,0 +1,73 @@
+#include "chunk.h"
+#include <catch.hpp>
+#include <forward_list>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	template <typename R>
+	std::vector<std::vector<int>> collect(R&& r)
+	{
+		std::vector<std::vector<int>> out;
+
+		for (auto const& chunk : r)
+		{
+			out.emplace_back(std::ranges::begin(chunk), std::ranges::end(chunk));
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("chunk splits into n elements with a shorter last chunk")
+{
+	std::vector const v{ 1, 2, 3, 4, 5 };
+	std::list const l(std::begin(v), std::end(v));
+	std::forward_list const f(std::begin(v), std::end(v));
+	std::vector<std::vector<int>> const expected{ { 1, 2 }, { 3, 4 }, { 5 } };
+
+	REQUIRE(collect(v | views::chunk(2)) == expected);
+	REQUIRE(collect(l | views::chunk(2)) == expected);
+	REQUIRE(collect(f | views::chunk(2)) == expected);
+	REQUIRE((v | views::chunk(2)).size() == 3);
+	REQUIRE(collect(v | views::chunk(5)) == std::vector<std::vector<int>>{ v });
+	REQUIRE(collect(v | views::chunk(9)) == std::vector<std::vector<int>>{ v });
+	REQUIRE(std::ranges::empty(std::vector<int>{} | views::chunk(3)));
+}
+
+TEST_CASE("chunk steps back from the end onto a short or whole last chunk")
+{
+	for (int size{ 1 }; size < 12; ++size)
+	{
+		for (int n{ 1 }; n < 5; ++n)
+		{
+			std::vector<int> v(size);
+			std::iota(std::begin(v), std::end(v), 0);
+			std::list const l(std::begin(v), std::end(v));
+
+			auto const forward{ collect(v | views::chunk(n)) };
+			std::vector<std::vector<int>> backward{ std::rbegin(forward), std::rend(forward) };
+
+			REQUIRE(collect(v | views::chunk(n) | std::views::reverse) == backward);
+			REQUIRE(collect(l | views::chunk(n) | std::views::reverse) == backward);
+
+			auto const chunks{ v | views::chunk(n) };
+
+			REQUIRE(chunks.end() - chunks.begin() == std::ssize(forward));
+			REQUIRE(std::ranges::equal(chunks.begin()[std::ssize(forward) - 1], forward.back()));
+			REQUIRE(std::ranges::equal(*(chunks.end() - 1), forward.back()));
+		}
+	}
+}
+
+TEST_CASE("chunk rejects a size that is not positive")
+{
+	std::vector const v{ 1, 2, 3 };
+
+	REQUIRE_THROWS_AS(v | views::chunk(0), std::out_of_range);
+	REQUIRE_THROWS_AS(v | views::chunk(-2), std::out_of_range);
+}
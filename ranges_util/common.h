@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
 
 namespace detail
 {
@@ -16,11 +21,67 @@ namespace detail
 			return std::forward_iterator_tag{};
 		else if constexpr ((std::ranges::input_range<Ts> && ...))
 			return std::input_iterator_tag{};
-		else if constexpr ((std::ranges::output_range<Ts> && ...))
+		else if constexpr ((std::ranges::range<Ts> && ...))
 			return std::output_iterator_tag{};
 		else
-			static_assert(false, "There are types that are not iterators");
+			static_assert(sizeof...(Ts) == 0, "There are types that are not iterators");
 	}
+
+	template <typename T>
+	concept character = std::same_as<std::remove_cv_t<T>, char> || std::same_as<std::remove_cv_t<T>, wchar_t> ||
+		std::same_as<std::remove_cv_t<T>, char8_t> || std::same_as<std::remove_cv_t<T>, char16_t> || std::same_as<std::remove_cv_t<T>, char32_t>;
+
+	//Sub-range [first, last) that stays contiguous when the iterators are:
+	//std::basic_string_view for characters, std::span for anything else, std::ranges::subrange otherwise
+	template <std::forward_iterator I>
+	constexpr auto make_chunk(I first, I last)
+	{
+		if constexpr (std::contiguous_iterator<I>)
+		{
+			using element_type = std::remove_reference_t<std::iter_reference_t<I>>;
+			auto const size{ static_cast<std::size_t>(last - first) };
+
+			if constexpr (character<element_type>)
+				return std::basic_string_view<std::remove_cv_t<element_type>>{ std::to_address(first), size };
+			else
+				return std::span<element_type>{ std::to_address(first), size };
+		}
+		else
+		{
+			return std::ranges::subrange{ std::move(first), std::move(last) };
+		}
+	}
+
+	template <typename I>
+	using chunk_t = decltype(make_chunk(std::declval<I>(), std::declval<I>()));
+
+	//Bytes of the stack buffer append_staged fills, small enough to stay in L1
+	constexpr std::size_t staging_block_bytes = 4096;
+
+	//Appends count elements of type T to c one block at a time: fill(out, first, n) writes elements [first, first + n)
+	//to a buffer on the stack, which is appended with a single insert
+	//Lets views fill a reserved container in bulk without resizing it first, which would value-initialize every
+	//element only to overwrite it
+	template <typename T, typename C, typename Fill>
+	void append_staged(C& c, std::size_t count, Fill fill)
+	{
+		constexpr auto block{ std::max<std::size_t>(staging_block_bytes / sizeof(T), 1) };
+
+		T buffer[block];
+
+		for (std::size_t first{ 0 }; first < count; first += block)
+		{
+			auto const n{ std::min(block, count - first) };
+
+			fill(buffer, first, n);
+			c.insert(std::end(c), buffer, buffer + n);
+		}
+	}
+
+	//Sized range whose iterators can jump forward with +=, without necessarily being random access iterators
+	template <typename R>
+	concept seekable_sized_range = std::ranges::sized_range<R>
+		&& requires(std::ranges::iterator_t<R> it, std::ranges::range_difference_t<R> n) { it += n; };
 }
 
 template <typename... Ts>
@@ -34,4 +95,10 @@ concept simple_view = std::ranges::view<R> && std::ranges::range<R const> &&
 struct begin_tag_t{};
 constexpr inline begin_tag_t begin_tag;
 struct end_tag_t{};
-constexpr inline end_tag_t end_tag;
\ No newline at end of file
+constexpr inline end_tag_t end_tag;
+//Promises that the elements are sorted by the grouping key
+struct sorted_tag_t{};
+constexpr inline sorted_tag_t sorted_tag;
+//Lets a view yield its elements in whatever order is cheapest instead of its documented one
+struct any_order_tag_t{};
+constexpr inline any_order_tag_t any_order_tag;
\ No newline at end of file
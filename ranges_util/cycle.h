@@ -1,5 +1,9 @@
 #pragma once
 
+#include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <ranges>
 #include <type_traits>
@@ -18,18 +22,20 @@ class cycle_view
     {
         using Base = std::conditional_t<Const, const T, T>;
 
+        //Bounds of the base are looked up once, stepping never calls std::ranges::begin/end again
         std::ranges::iterator_t<Base> current_{};
-        Base* base_ = nullptr;
+        std::ranges::iterator_t<Base> begin_{};
+        std::ranges::sentinel_t<Base> end_{};
 
     public:
-        using iterator_category = typename std::iterator_traits<std::ranges::iterator_t<Base>>::iterator_category;
+        using iterator_category = common_iterator_category<Base>;
         using reference = std::ranges::range_reference_t<Base>;
         using value_type = std::ranges::range_value_t<Base>;
         using difference_type = std::ranges::range_difference_t<Base>;
 
         iterator() = default;
         constexpr explicit iterator(std::ranges::iterator_t<Base> current, Base* base)
-            : current_{ std::move(current) }, base_{ base }
+            : current_{ std::move(current) }, begin_{ std::ranges::begin(*base) }, end_{ std::ranges::end(*base) }
         {
 
         }
@@ -38,7 +44,7 @@ class cycle_view
             std::ranges::iterator_t<T>,
             std::ranges::iterator_t<Base>
         >
-            : current_{ std::move(i.current_) } 
+            : current_{ std::move(i.current_) }, begin_{ std::move(i.begin_) }, end_{ std::move(i.end_) }
         {
         
         }
@@ -63,9 +69,9 @@ class cycle_view
         {
             ++current_;
 
-            if (current_ == std::ranges::end(*base_))
+            if (current_ == end_)
             {
-                current_ = std::ranges::begin(*base_);
+                current_ = begin_;
             }
 
             return *this;
@@ -88,9 +94,9 @@ class cycle_view
         constexpr iterator& operator--() 
             requires std::ranges::bidirectional_range<Base>
         {
-            if (current_ == std::ranges::begin(*base_))
+            if (current_ == begin_)
             {
-                current_ = std::ranges::end(*base_);
+                current_ = std::ranges::next(begin_, end_);
             }
 
             --current_;
@@ -111,13 +117,20 @@ class cycle_view
         constexpr iterator& operator+=(difference_type x) 
             requires std::ranges::random_access_range<Base> 
         {
-            auto const begin{ std::ranges::begin(*base_) };
-            auto const end{ std::ranges::end(*base_) };
-            auto const size{ end - begin };
-            auto const distance_from_begin{ current_ - begin };
-            auto const offset{ (distance_from_begin + x) % size };
+            auto const size{ end_ - begin_ };
+            auto const target{ (current_ - begin_) + x };
 
-            current_ = begin + static_cast<difference_type>(offset < 0 ? offset + size : offset);
+            //Only jumps that wrap around need the modulo
+            if (target >= 0 && target < size)
+            {
+                current_ += x;
+            }
+            else
+            {
+                auto const offset{ target % size };
+
+                current_ = begin_ + static_cast<difference_type>(offset < 0 ? offset + size : offset);
+            }
 
             return *this;
         }
@@ -191,7 +204,7 @@ class cycle_view
         friend constexpr iterator operator-(const iterator& x, difference_type y)
             requires std::ranges::random_access_range<Base>
         {
-            return iterator{ x } - y;
+            return iterator{ x } -= y;
         }
 
         friend class iterator<!Const>;
@@ -220,6 +233,15 @@ public:
         return sentinel{}; 
     }
 
+    //Elements [first, last) of the infinite cycle, starting in the right phase of the base
+    constexpr auto subrange_at(std::size_t first, std::size_t last) const
+        requires std::ranges::random_access_range<const T> && std::ranges::sized_range<const T>
+    {
+        using difference_type = std::ranges::range_difference_t<const T>;
+
+        return std::views::counted(begin() + static_cast<difference_type>(first), static_cast<difference_type>(last - first));
+    }
+
     constexpr T base() const& requires std::copy_constructible<T> 
     {
         return base_;
@@ -234,6 +256,300 @@ public:
 template <class R>
 cycle_view(R&&)->cycle_view<std::views::all_t<R>>;
 
+//Bounded cycle producing exactly count elements (views::cycle | std::views::take(count)),
+//but sized and common so containers can reserve up front
+template <std::ranges::forward_range T>
+requires std::ranges::view<T>
+class cycle_n_view
+    : public std::ranges::view_interface<cycle_n_view<T>>
+{
+public:
+    using count_type = std::ranges::range_difference_t<T>;
+
+private:
+    T base_;
+    count_type count_ = 0;
+
+    template <bool Const>
+    class iterator 
+    {
+        using Base = std::conditional_t<Const, const T, T>;
+
+        std::ranges::iterator_t<Base> current_{};
+        count_type pos_ = 0;
+        std::ranges::iterator_t<Base> begin_{};
+        std::ranges::sentinel_t<Base> end_{};
+
+    public:
+        //+=, - and [] need the size of the base to wrap around, so an unsized random access base only gets a
+        //bidirectional iterator
+        using iterator_category = std::conditional_t<
+            std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>, std::random_access_iterator_tag, std::conditional_t<
+            std::ranges::bidirectional_range<Base>, std::bidirectional_iterator_tag, std::forward_iterator_tag>>;
+        using reference = std::ranges::range_reference_t<Base>;
+        using value_type = std::ranges::range_value_t<Base>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        constexpr explicit iterator(std::ranges::iterator_t<Base> current, count_type pos, Base* base)
+            : current_{ std::move(current) }, pos_{ pos }, begin_{ std::ranges::begin(*base) }, end_{ std::ranges::end(*base) }
+        {
+
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<
+            std::ranges::iterator_t<T>,
+            std::ranges::iterator_t<Base>
+        >
+            : current_{ std::move(i.current_) }, pos_{ i.pos_ }, begin_{ std::move(i.begin_) }, end_{ std::move(i.end_) }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const 
+        {
+            return *current_;
+        }
+
+        constexpr iterator& operator++() 
+        {
+            ++current_;
+            ++pos_;
+
+            if (current_ == end_)
+            {
+                current_ = begin_;
+            }
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int) 
+        {
+            auto temp{ *this };
+
+            this->operator++();
+
+            return temp;
+        }
+
+        constexpr iterator& operator--() 
+            requires std::ranges::bidirectional_range<Base>
+        {
+            if (current_ == begin_)
+            {
+                current_ = std::ranges::next(begin_, end_);
+            }
+
+            --current_;
+            --pos_;
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+            requires std::ranges::bidirectional_range<Base> 
+        {
+            auto const temp{ *this };
+
+            this->operator--();
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type x) 
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            auto const size{ end_ - begin_ };
+            auto const target{ (current_ - begin_) + x };
+
+            pos_ += x;
+            current_ = target >= 0 && target < size ? current_ + x : begin_ + pos_ % size;
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type x)
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            return this->operator+=(-x);
+        }
+
+        constexpr decltype(auto) operator[](difference_type n) const
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            return *((*this) + n);
+        }
+
+        friend constexpr bool operator==(const iterator& x, const iterator& y)
+        {
+            return x.pos_ == y.pos_;
+        }
+
+        friend constexpr auto operator<=>(const iterator& x, const iterator& y)
+        {
+            return x.pos_ <=> y.pos_;
+        }
+
+        friend constexpr iterator operator+(const iterator& x, difference_type y)
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            return iterator{ x } += y;
+        }
+
+        friend constexpr iterator operator+(difference_type x, const iterator& y)
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            return y + x;
+        }
+
+        friend constexpr iterator operator-(const iterator& x, difference_type y)
+            requires std::ranges::random_access_range<Base> && std::ranges::sized_range<Base>
+        {
+            return iterator{ x } -= y;
+        }
+
+        friend constexpr difference_type operator-(const iterator& x, const iterator& y)
+        {
+            return x.pos_ - y.pos_;
+        }
+
+        friend class iterator<!Const>;
+    };
+
+    //Position of the base iterator after count_ elements, only needed to step back from end()
+    template <typename Base>
+    constexpr auto end_position(Base& base) const
+    {
+        auto first{ std::ranges::begin(base) };
+
+        if constexpr (std::ranges::bidirectional_range<Base>)
+        {
+            auto const size{ static_cast<count_type>(std::ranges::distance(base)) };
+
+            return std::ranges::next(first, count_ % size);
+        }
+        else
+        {
+            return first;
+        }
+    }
+
+public:
+    cycle_n_view() = default;
+    //A negative count is taken as 0
+    cycle_n_view(T base, count_type count)
+        : base_(std::move(base)), count_{ std::ranges::empty(base_) ? 0 : std::max<count_type>(count, 0) }
+    {
+
+    }
+
+    constexpr auto begin() 
+    {
+        return iterator<false>(std::ranges::begin(base_), 0, std::addressof(base_));
+    }
+
+    constexpr auto begin() const 
+    {
+        return iterator<true>(std::ranges::begin(base_), 0, std::addressof(base_));
+    }
+
+    constexpr auto end()
+    { 
+        return iterator<false>(count_ == 0 ? std::ranges::begin(base_) : end_position(base_), count_, std::addressof(base_));
+    }
+
+    constexpr auto end() const
+    { 
+        return iterator<true>(count_ == 0 ? std::ranges::begin(base_) : end_position(base_), count_, std::addressof(base_));
+    }
+
+    constexpr auto size() const
+    {
+        return static_cast<std::make_unsigned_t<count_type>>(count_);
+    }
+
+    //Elements [first, last), with iterators that keep both the phase of the base and the position in the count
+    constexpr auto subrange_at(std::size_t first, std::size_t last) const
+        requires std::ranges::random_access_range<const T> && std::ranges::sized_range<const T>
+    {
+        return std::ranges::subrange(begin() + static_cast<count_type>(first), begin() + static_cast<count_type>(last));
+    }
+
+    //Append all count elements to c, picked up by to<> (see detail::bulk_appendable)
+    //Contiguous trivially copyable bases fill a block of whole periods once, by copying the pattern and then doubling
+    //the filled prefix with memcpy, and append that block over and over; a period longer than the block is appended
+    //straight from the base
+    template <typename C>
+    requires requires (C& c, std::ranges::range_value_t<T> const* p) { c.insert(std::end(c), p, p); }
+    void append_to(C& c) const
+    {
+        using value_type = std::ranges::range_value_t<T>;
+
+        if constexpr (std::ranges::contiguous_range<T const> && std::ranges::sized_range<T const> && std::is_trivially_copyable_v<value_type>)
+        {
+            auto const total{ static_cast<std::size_t>(count_) };
+            auto const period{ static_cast<std::size_t>(std::ranges::size(base_)) };
+            auto const* const pattern{ std::ranges::data(base_) };
+            constexpr auto capacity{ std::max<std::size_t>(detail::staging_block_bytes / sizeof(value_type), 1) };
+
+            if (total == 0)
+            {
+                return;
+            }
+
+            if (period > capacity)
+            {
+                for (std::size_t filled{ 0 }; filled < total; filled += period)
+                {
+                    c.insert(std::end(c), pattern, pattern + std::min(period, total - filled));
+                }
+
+                return;
+            }
+
+            //Raw storage, so value_type does not have to be default constructible; memcpy creates the elements in it
+            alignas(value_type) std::byte storage[capacity * sizeof(value_type)];
+            auto* const block{ reinterpret_cast<value_type*>(storage) };
+            auto const length{ std::min(total, capacity / period * period) };
+
+            std::memcpy(block, pattern, period * sizeof(value_type));
+
+            //The filled prefix is always a whole number of periods, so copying it keeps the phase
+            for (auto filled{ period }; filled < length; )
+            {
+                auto const n{ std::min(filled, length - filled) };
+
+                std::memcpy(block + filled, block, n * sizeof(value_type));
+                filled += n;
+            }
+
+            //Every block starts at the beginning of a period, so the last one is a prefix of the block
+            for (std::size_t appended{ 0 }; appended < total; appended += length)
+            {
+                c.insert(std::end(c), block, block + std::min(length, total - appended));
+            }
+        }
+        else
+        {
+            std::ranges::copy(*this, std::back_inserter(c));
+        }
+    }
+
+    constexpr T base() const& requires std::copy_constructible<T> 
+    {
+        return base_;
+    }
+
+    constexpr T base()&& 
+    { 
+        return std::move(base_); 
+    }
+};
+
+template <class R>
+cycle_n_view(R&&, std::ranges::range_difference_t<R>)->cycle_n_view<std::views::all_t<R>>;
+
 namespace views
 {
     namespace detail
@@ -256,4 +572,37 @@ namespace views
     }
 
     inline constexpr detail::cycle_fn cycle;
-}
+
+    namespace detail
+    {
+        template <std::integral D>
+        struct cycle_n_closure
+        {
+            D count_;
+
+            template <std::ranges::viewable_range T>
+            friend constexpr auto operator|(T&& t, cycle_n_closure const& clos)
+            {
+                return cycle_n_view{ std::forward<T>(t), clos.count_ };
+            }
+        };
+
+        class cycle_n_fn
+        {
+        public:
+            template <std::ranges::viewable_range T>
+            constexpr auto operator()(T&& t, std::ranges::range_difference_t<T> count) const
+            {
+                return cycle_n_view{ std::forward<T>(t), count };
+            }
+
+            template <std::integral D>
+            constexpr auto operator()(D count) const
+            {
+                return cycle_n_closure<D>{ count };
+            }
+        };
+    }
+
+    inline constexpr detail::cycle_n_fn cycle_n;
+}
\ No newline at end of file
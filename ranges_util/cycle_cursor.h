@@ -0,0 +1,83 @@
+#pragma once
+
+#include "cycle.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+//Round-robin cursor over a cycle that many threads can draw from without locking
+//Every claim is a single atomic fetch-add on a shared ticket counter; the ticket is turned into
+//a position with cycle_view's random access arithmetic, so the base has to be sized and random access
+template <std::ranges::random_access_range T>
+requires std::ranges::view<T> && std::ranges::sized_range<T const>
+class shared_cycle_cursor
+{
+public:
+    explicit shared_cycle_cursor(T base)
+        : size_{ checked_size(base) },
+        cycle_{ std::move(base) }, begin_{ std::as_const(cycle_).begin() }
+    {
+
+    }
+
+    shared_cycle_cursor(shared_cycle_cursor const&) = delete;
+    shared_cycle_cursor& operator=(shared_cycle_cursor const&) = delete;
+
+    //Next element in round-robin order
+    decltype(auto) next()
+    {
+        return begin_[to_offset(tickets_.fetch_add(1, std::memory_order_relaxed))];
+    }
+
+    //Reserve the next count elements with one atomic operation, for dispatchers that hand out work in batches
+    auto claim(std::size_t count)
+    {
+        auto const first{ tickets_.fetch_add(count, std::memory_order_relaxed) };
+
+        return std::views::counted(begin_ + to_offset(first), static_cast<difference_type>(count));
+    }
+
+    //Number of elements handed out so far
+    std::uint64_t claimed() const
+    {
+        return tickets_.load(std::memory_order_relaxed);
+    }
+
+private:
+    using iterator = decltype(std::declval<cycle_view<T> const&>().begin());
+    using difference_type = std::iter_difference_t<iterator>;
+
+    //Keep the ticket counter on its own cache line so it does not share it with the read-only members
+    static constexpr std::size_t cache_line_size = 64;
+
+    std::uint64_t size_;
+    cycle_view<T> cycle_;
+    iterator begin_;
+    alignas(cache_line_size) std::atomic<std::uint64_t> tickets_{ 0 };
+
+    //An empty base has no position to hand out, and every ticket would divide by its size of 0
+    static std::uint64_t checked_size(T const& base)
+    {
+        auto const size{ static_cast<std::uint64_t>(std::ranges::size(base)) };
+
+        if (size == 0)
+        {
+            throw std::out_of_range("shared_cycle_cursor: the base is empty");
+        }
+
+        return size;
+    }
+
+    //Tickets only grow, so reduce them modulo the size while they are still unsigned; masking them into the range of
+    //difference_type instead would shift the phase of the rotation once the count passes 2^63
+    difference_type to_offset(std::uint64_t ticket) const
+    {
+        return static_cast<difference_type>(ticket % size_);
+    }
+};
+
+template <class R>
+shared_cycle_cursor(R&&)->shared_cycle_cursor<std::views::all_t<R>>;
\ No newline at end of file
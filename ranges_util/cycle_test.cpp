@@ -0,0 +1,169 @@
+#include "cycle.h"
+#include "cycle_cursor.h"
+#include "to.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <list>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::vector<int> repeat(std::vector<int> const& pattern, std::size_t count)
+	{
+		std::vector<int> out;
+
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			out.push_back(pattern[i % pattern.size()]);
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("cycle_n over an unsized random access base is bidirectional")
+{
+	auto const base{ std::views::iota(0) | std::views::take_while([](int i) { return i < 3; }) };
+	auto const view{ base | views::cycle_n(7) };
+
+	STATIC_REQUIRE(std::ranges::bidirectional_range<decltype(view)>);
+	STATIC_REQUIRE(!std::ranges::random_access_range<decltype(view)>);
+	REQUIRE(std::ranges::equal(view, std::vector{ 0, 1, 2, 0, 1, 2, 0 }));
+	REQUIRE(*std::ranges::prev(view.end()) == 0);
+}
+
+TEST_CASE("cycle over a base whose iterators are only C++20 iterators")
+{
+	//transform yielding prvalues has an input_iterator_tag category but models random_access_iterator
+	auto const base{ std::views::iota(0, 3) | std::views::transform([](int i) { return i * 10; }) };
+	auto view{ base | views::cycle };
+	auto it{ view.begin() };
+
+	STATIC_REQUIRE(std::same_as<std::iterator_traits<decltype(it)>::iterator_category, std::random_access_iterator_tag>);
+	STATIC_REQUIRE(std::bidirectional_iterator<decltype(it)>);
+	REQUIRE(it[4] == 10);
+	REQUIRE(*--it == 20);
+	REQUIRE(std::ranges::equal(view | std::views::take(5), std::vector{ 0, 10, 20, 0, 10 }));
+}
+
+TEST_CASE("cycle_n with a negative count is empty")
+{
+	std::vector const a{ 1, 2, 3 };
+	auto const view{ a | views::cycle_n(-5) };
+
+	REQUIRE(view.size() == 0);
+	REQUIRE(view.begin() == view.end());
+	REQUIRE(to<std::vector<int>>(view).empty());
+}
+
+TEST_CASE("to<> appends cycle_n in bulk")
+{
+	for (std::size_t period : { 1, 3, 1000, 1024, 5000 })
+	{
+		std::vector<int> pattern(period);
+		std::iota(std::begin(pattern), std::end(pattern), 1);
+
+		for (std::size_t count : { 0, 1, 2, 999, 1024, 4096, 20000 })
+		{
+			auto const view{ pattern | views::cycle_n(static_cast<std::ptrdiff_t>(count)) };
+
+			REQUIRE(to<std::vector<int>>(view) == repeat(pattern, count));
+		}
+	}
+
+	std::list const l{ 4, 5 };
+
+	REQUIRE(to<std::vector<int>>(l | views::cycle_n(5)) == std::vector{ 4, 5, 4, 5, 4 });
+}
+
+TEST_CASE("to<> appends cycle_n of a type without a default constructor")
+{
+	struct point
+	{
+		explicit point(int x)
+			: x{ x }
+		{
+
+		}
+
+		bool operator==(point const&) const = default;
+
+		int x;
+	};
+
+	STATIC_REQUIRE(std::is_trivially_copyable_v<point>);
+	STATIC_REQUIRE(!std::default_initializable<point>);
+
+	std::vector const pattern{ point{ 1 }, point{ 2 }, point{ 3 } };
+	std::vector<point> expected;
+
+	for (std::size_t i{ 0 }; i < 5000; ++i)
+	{
+		expected.push_back(pattern[i % pattern.size()]);
+	}
+
+	REQUIRE(to<std::vector<point>>(pattern | views::cycle_n(5000)) == expected);
+}
+
+TEST_CASE("shared_cycle_cursor keeps its phase past 2^63 claims")
+{
+	std::vector const backends{ 0, 1, 2 };
+	shared_cycle_cursor cursor{ backends };
+
+	REQUIRE(cursor.next() == 0);
+	REQUIRE(cursor.next() == 1);
+
+	//Two huge batches that are never walked, 2 + 2^63 tickets in all
+	static_cast<void>(cursor.claim(std::size_t{ 1 } << 62));
+	static_cast<void>(cursor.claim(std::size_t{ 1 } << 62));
+
+	REQUIRE(cursor.claimed() == (std::uint64_t{ 1 } << 63) + 2);
+	REQUIRE(cursor.next() == static_cast<int>(((std::uint64_t{ 1 } << 63) + 2) % backends.size()));
+}
+
+TEST_CASE("shared_cycle_cursor rejects an empty base")
+{
+	REQUIRE_THROWS_AS(shared_cycle_cursor{ std::vector<int>{} }, std::out_of_range);
+}
+
+TEST_CASE("shared_cycle_cursor hands out disjoint batches from many threads")
+{
+	//The base is longer than all the claims together, so every element is its own ticket
+	constexpr int thread_count{ 8 };
+	constexpr int batches{ 2000 };
+	shared_cycle_cursor cursor{ std::views::iota(0, 1 << 24) };
+	std::vector<std::vector<int>> seen(thread_count);
+
+	{
+		std::vector<std::jthread> threads;
+
+		for (int t{ 0 }; t < thread_count; ++t)
+		{
+			threads.emplace_back([&, t] {
+				for (int i{ 0 }; i < batches; ++i)
+				{
+					auto const batch{ cursor.claim(static_cast<std::size_t>(t + i % 3)) };
+
+					std::ranges::copy(batch, std::back_inserter(seen[t]));
+				}
+			});
+		}
+	}
+
+	std::vector<int> all;
+
+	for (auto const& s : seen)
+	{
+		REQUIRE(std::ranges::is_sorted(s));
+		all.insert(all.end(), s.begin(), s.end());
+	}
+
+	std::ranges::sort(all);
+
+	std::vector<int> expected(cursor.claimed());
+	std::iota(expected.begin(), expected.end(), 0);
+
+	REQUIRE(all == expected);
+}
@@ -1,22 +1,67 @@
 #pragma once
 
 #include "common.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <ranges>
+#include <stdexcept>
 #include <type_traits>
-#include <xutility>
+#include <utility>
 
+//Calls f(index, element) for every element, counting up from start
+//Contiguous sized ranges run as a single index loop over a pointer, the shape compilers vectorize,
+//instead of advancing an iterator and a count side by side and building a pair for every element
+template <std::ranges::input_range R, typename F, std::integral U = std::size_t>
+constexpr void enumerate_for_each(R&& r, F f, U start = U{})
+{
+	if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>)
+	{
+		auto* const data{ std::ranges::data(r) };
+		auto const size{ static_cast<std::size_t>(std::ranges::size(r)) };
+
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			std::invoke(f, static_cast<U>(start + i), data[i]);
+		}
+	}
+	else
+	{
+		auto index{ start };
+
+		for (auto&& e : r)
+		{
+			std::invoke(f, index, std::forward<decltype(e)>(e));
+			++index;
+		}
+	}
+}
+
+//U is the type of the yielded index, e.g. std::uint32_t halves the index column of enumerate | to<std::vector>
+//when the range is known to have fewer than 2^32 elements
 template <std::ranges::input_range T, std::integral U = std::size_t>
 requires std::ranges::view<T>
 class enumerate_view
-	: public std::ranges::view_interface<enumerate_view<T>>
+	: public std::ranges::view_interface<enumerate_view<T, U>>
 {
 public:
 	enumerate_view() = default;
 	enumerate_view(T base, U pos = U{})
 		: base_(std::move(base)), pos_(pos)
 	{
+		//The last index of a sized range has to be representable in U
+		if constexpr (std::ranges::sized_range<T>)
+		{
+			auto const size{ static_cast<std::uintmax_t>(std::ranges::size(base_)) };
+			auto const room{ static_cast<std::uintmax_t>(std::numeric_limits<U>::max()) - static_cast<std::uintmax_t>(pos_) };
 
+			if (size != 0 && size - 1 > room)
+			{
+				throw std::out_of_range("enumerate_view: index does not fit in the index type");
+			}
+		}
 	}
 
 	constexpr auto begin()
@@ -39,7 +84,7 @@ public:
 	constexpr auto end()
 		requires std::ranges::common_range<T> && std::ranges::sized_range<T>
 	{
-		return iterator<false>{ std::ranges::end(base_), static_cast<std::ranges::range_difference_t<T>>(size()) };
+		return iterator<false>{ std::ranges::end(base_), static_cast<U>(pos_ + size()) };
 	}
 
 	constexpr auto end() const
@@ -51,7 +96,7 @@ public:
 	constexpr auto end() const
 		requires std::ranges::common_range<T const> && std::ranges::sized_range<T>
 	{
-		return iterator<true>{ std::ranges::end(base_), static_cast<std::ranges::range_difference_t<T>>(size()) };
+		return iterator<true>{ std::ranges::end(base_), static_cast<U>(pos_ + size()) };
 	}
 
 	constexpr auto size()
@@ -66,6 +111,32 @@ public:
 		return std::ranges::size(base_);
 	}
 
+	//Push-based iteration, see enumerate_for_each
+	template <typename F>
+	constexpr void for_each(F f)
+	{
+		enumerate_for_each(base_, std::move(f), pos_);
+	}
+
+	template <typename F>
+	constexpr void for_each(F f) const
+		requires std::ranges::input_range<T const>
+	{
+		enumerate_for_each(base_, std::move(f), pos_);
+	}
+
+	//Elements [first, last) as an enumerate_view of their own that keeps counting from the right index
+	constexpr auto subrange_at(std::size_t first, std::size_t last) const
+		requires std::ranges::random_access_range<T const> && std::ranges::sized_range<T const>
+	{
+		auto const begin{ std::ranges::begin(base_) };
+		std::ranges::subrange piece{
+			begin + static_cast<std::ranges::range_difference_t<T const>>(first),
+			begin + static_cast<std::ranges::range_difference_t<T const>>(last) };
+
+		return enumerate_view<decltype(piece), U>{ std::move(piece), static_cast<U>(pos_ + first) };
+	}
+
 	constexpr auto base() const
 		requires std::copy_constructible<T>
 	{
@@ -87,25 +158,20 @@ private:
 	class iterator
 	{
 		using Base = std::conditional_t<Const, T const, T>;
-		using count_type = decltype([] {
-			if constexpr (std::ranges::sized_range<Base>)
-				return std::ranges::range_size_t<Base>();
-			else
-				return std::make_unsigned_t<std::ranges::range_difference_t<Base>>();
-			}());
+		using count_type = U;
 
 		std::ranges::iterator_t<Base> current_{};
 		count_type pos_ = 0;
 
 	public:
-		using iterator_category = typename std::iterator_traits<std::ranges::iterator_t<Base>>::iterator_category;
+		using iterator_category = common_iterator_category<Base>;
 		using reference = std::pair<count_type, std::ranges::range_reference_t<Base>>;
 		using value_type = std::pair<count_type, std::ranges::range_value_t<Base>>;
 		using difference_type = std::ranges::range_difference_t<Base>;
 
 		iterator() = default;
-		constexpr explicit iterator(std::ranges::iterator_t<Base> current, difference_type pos)
-			: current_{ std::move(current) }, pos_{ static_cast<count_type>(pos) }
+		constexpr explicit iterator(std::ranges::iterator_t<Base> current, count_type pos)
+			: current_{ std::move(current) }, pos_{ pos }
 		{
 
 		}
@@ -167,7 +233,7 @@ private:
 			--pos_;
 			--current_;
 
-			return **this;
+			return *this;
 		}
 
 		constexpr iterator operator--(int)
@@ -184,7 +250,7 @@ private:
 		constexpr iterator& operator+=(difference_type x)
 			requires std::ranges::random_access_range<Base>
 		{
-			pos_ += x;
+			pos_ = static_cast<count_type>(pos_ + x);
 			current_ += x;
 
 			return *this;
@@ -193,7 +259,7 @@ private:
 		constexpr iterator& operator-=(difference_type x)
 			requires std::ranges::random_access_range<Base>
 		{
-			pos_ -= x;
+			pos_ = static_cast<count_type>(pos_ - x);
 			current_ -= x;
 
 			return *this;
@@ -202,7 +268,7 @@ private:
 		constexpr decltype(auto) operator[](difference_type n) const
 			requires std::ranges::random_access_range<Base>
 		{
-			return reference{ static_cast<difference_type>(pos_ + n), *(current_ + n) };
+			return reference{ static_cast<count_type>(pos_ + n), *(current_ + n) };
 		}
 
 		friend constexpr bool operator==(iterator const& x, iterator const& y)
@@ -261,13 +327,13 @@ private:
 		friend constexpr iterator operator-(iterator const& x, difference_type y)
 			requires std::ranges::random_access_range<Base>
 		{
-			return iterator{ x } - y;
+			return iterator{ x } -= y;
 		}
 
-		friend constexpr iterator operator-(iterator const& x, iterator const& y)
-			requires std::ranges::random_access_range<Base>
+		friend constexpr difference_type operator-(iterator const& x, iterator const& y)
+			requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>>
 		{
-			return y - x;
+			return x.current_ - y.current_;
 		}
 
 		template <bool>
@@ -301,15 +367,23 @@ private:
 			return end_;
 		}
 
+		//Reads the iterator of the base in place, since input iterators such as a generator's cannot be copied out
+		template <bool OtherConst>
+		constexpr bool equal(iterator<OtherConst> const& x) const
+		{
+			return x.current_ == end_;
+		}
+
 		friend constexpr bool operator==(iterator<Const> const& x, sentinel const& y)
 		{
-			return x.base() == y.end_;
+			return y.equal(x);
 		}
 
 		// Note: std::views(0) | views::enumerate ϸ    ߰
 		friend constexpr bool operator==(iterator<!Const> const& x, sentinel const& y)
+			requires std::ranges::range<std::conditional_t<Const, T, T const>>
 		{
-			return x.base() == y.end_;
+			return y.equal(x);
 		}
 
 		friend constexpr std::ranges::range_difference_t<Base> operator-(iterator<Const> const& x, sentinel const& y)
@@ -345,13 +419,41 @@ namespace views
 				return enumerate_view{ std::forward<T>(t) };
 			}
 
+			//Counts up from start, yielding indices of start's type
+			template <std::ranges::viewable_range T, std::integral U>
+			constexpr auto operator()(T&& t, U start) const
+			{
+				return enumerate_view{ std::forward<T>(t), start };
+			}
+
 			template <std::ranges::viewable_range T>
 			friend constexpr auto operator|(T&& t, enumerate_fn)
 			{
 				return enumerate_view{ std::forward<T>(t) };
 			}
 		};
+
+		template <std::integral U>
+		class enumerate_as_fn
+		{
+		public:
+			template <std::ranges::viewable_range T>
+			constexpr auto operator()(T&& t, U start = U{}) const
+			{
+				return enumerate_view{ std::forward<T>(t), start };
+			}
+
+			template <std::ranges::viewable_range T>
+			friend constexpr auto operator|(T&& t, enumerate_as_fn)
+			{
+				return enumerate_view{ std::forward<T>(t), U{} };
+			}
+		};
 	}
 
 	inline constexpr detail::enumerate_fn enumerate;
+
+	//views::enumerate with indices of type U, e.g. v | views::enumerate_as<std::uint32_t>
+	template <std::integral U>
+	inline constexpr detail::enumerate_as_fn<U> enumerate_as;
 }
\ No newline at end of file
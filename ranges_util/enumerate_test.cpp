@@ -1,5 +1,9 @@
 #include "enumerate.h"
 #include <catch.hpp>
+#include <list>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 TEST_CASE("basic vector")
 {
@@ -71,4 +75,112 @@ TEST_CASE("unsized view")
 	{
 		REQUIRE(i == j);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("compact index type")
+{
+	std::vector a{ 1, 2, 3 };
+	auto view{ a | views::enumerate_as<std::uint32_t> };
+
+	STATIC_REQUIRE(std::is_same_v<std::ranges::range_value_t<decltype(view)>::first_type, std::uint32_t>);
+	STATIC_REQUIRE(sizeof(std::ranges::range_value_t<decltype(view)>) == 8);
+
+	std::uint32_t i{ 0 };
+
+	for (auto&& [index, item] : view)
+	{
+		REQUIRE(index == i);
+		++i;
+	}
+
+	REQUIRE_THROWS_AS(std::views::iota(0, 300) | views::enumerate_as<std::uint8_t>, std::out_of_range);
+	REQUIRE_NOTHROW(std::views::iota(0, 256) | views::enumerate_as<std::uint8_t>);
+}
+
+TEST_CASE("start offset")
+{
+	std::vector a{ 1, 2, 3 };
+	auto view{ views::enumerate(a, std::uint32_t{ 10 }) };
+
+	REQUIRE((*view.begin()).first == 10);
+	REQUIRE((*std::ranges::prev(view.end())).first == 12);
+	REQUIRE(view.end() - view.begin() == 3);
+	REQUIRE(view.begin()[2].first == 12);
+	REQUIRE_THROWS_AS(views::enumerate(a, std::uint8_t{ 254 }), std::out_of_range);
+}
+
+TEST_CASE("move-only input range")
+{
+	std::istringstream in{ "5 6 7" };
+	std::size_t i{ 0 };
+
+	for (auto&& [index, item] : std::views::istream<int>(in) | views::enumerate)
+	{
+		REQUIRE(index == i);
+		REQUIRE(item == static_cast<int>(i) + 5);
+		++i;
+	}
+
+	REQUIRE(i == 3);
+}
+
+TEST_CASE("enumerate_for_each matches the iterators")
+{
+	std::vector v{ 4, 5, 6, 7 };
+	std::list l(std::begin(v), std::end(v));
+
+	auto const pairs{ [](auto&& r, auto start) {
+		std::vector<std::pair<std::size_t, int>> out;
+
+		enumerate_for_each(r, [&](auto index, int item) { out.emplace_back(index, item); }, start);
+
+		return out;
+	} };
+	auto const iterated{ [](auto&& view) {
+		std::vector<std::pair<std::size_t, int>> out;
+
+		for (auto&& [index, item] : view)
+		{
+			out.emplace_back(index, item);
+		}
+
+		return out;
+	} };
+
+	//The contiguous fast path, the iterator fallback and a start other than zero
+	REQUIRE(pairs(v, std::size_t{ 0 }) == iterated(v | views::enumerate));
+	REQUIRE(pairs(l, std::size_t{ 0 }) == iterated(l | views::enumerate));
+	REQUIRE(pairs(v, std::uint32_t{ 10 }) == iterated(views::enumerate(v, std::uint32_t{ 10 })));
+	REQUIRE(pairs(l, std::uint32_t{ 10 }) == iterated(views::enumerate(l, std::uint32_t{ 10 })));
+	REQUIRE(pairs(std::vector<int>{}, std::size_t{ 0 }).empty());
+
+	//Elements are passed by reference on both paths
+	enumerate_for_each(v, [](auto index, int& item) { item += static_cast<int>(index); });
+	enumerate_for_each(l, [](auto index, int& item) { item += static_cast<int>(index); });
+
+	REQUIRE(v == std::vector{ 4, 6, 8, 10 });
+	REQUIRE(l == std::list{ 4, 6, 8, 10 });
+}
+
+TEST_CASE("enumerate_view::for_each starts at the view's index")
+{
+	std::vector v{ 1, 2, 3 };
+	std::list l{ 1, 2, 3 };
+
+	for (auto const start : { std::size_t{ 0 }, std::size_t{ 7 } })
+	{
+		std::vector<std::pair<std::size_t, int>> from_vector;
+		std::vector<std::pair<std::size_t, int>> from_list;
+
+		auto const vector_view{ views::enumerate(v, start) };
+		auto list_view{ views::enumerate(l, start) };
+
+		vector_view.for_each([&](std::size_t index, int item) { from_vector.emplace_back(index, item); });
+		list_view.for_each([&](std::size_t index, int item) { from_list.emplace_back(index, item); });
+
+		std::vector<std::pair<std::size_t, int>> const expected{ { start, 1 }, { start + 1, 2 }, { start + 2, 3 } };
+
+		REQUIRE(from_vector == expected);
+		REQUIRE(from_list == expected);
+	}
+}
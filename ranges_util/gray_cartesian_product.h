@@ -0,0 +1,223 @@
+#pragma once
+
+#include "common.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//Cartesian product in reflected Gray code (boustrophedon) order: every step moves exactly one base by one element
+//Instead of wrapping around, a base that reaches either end reverses direction while the next outer one steps,
+//e.g. over { 0, 1 } x { 0, 1, 2 } the order is (0,0) (0,1) (0,2) (1,2) (1,1) (1,0)
+//The iterator reports which base changed and its old and new element, so a cost function can be updated
+//in O(1) per step instead of being recomputed over every base
+template <std::ranges::bidirectional_range... Ts>
+requires (std::ranges::view<Ts> && ...) && (sizeof...(Ts) > 0)
+class gray_cartesian_product_view
+    : public std::ranges::view_interface<gray_cartesian_product_view<Ts...>>
+{
+    std::tuple<Ts...> bases_;
+
+    template <bool Const>
+    class iterator
+    {
+        template<typename T>
+        using constify = std::conditional_t<Const, const T, T>;
+
+        static constexpr std::size_t dimensions = sizeof...(Ts);
+
+        constify<std::tuple<Ts...>>* bases_ = nullptr;
+        std::tuple<std::ranges::iterator_t<constify<Ts>>...> currents_{};
+        //true while a base is walked from begin towards end
+        std::array<bool, dimensions> forward_{};
+        std::size_t changed_ = dimensions;
+
+        //Move std::get<N>(currents_) one step in its direction
+        //A base that is already at the far end flips direction and passes the step on to std::get<N-1>
+        template <std::size_t N = (dimensions - 1)>
+        constexpr void next()
+        {
+            auto& it{ std::get<N>(currents_) };
+            auto const& base{ std::get<N>(*bases_) };
+
+            if (forward_[N] ? std::ranges::next(it) != std::ranges::end(base) : it != std::ranges::begin(base))
+            {
+                forward_[N] ? ++it : --it;
+                changed_ = N;
+
+                return;
+            }
+
+            forward_[N] = !forward_[N];
+
+            if constexpr (N > 0)
+            {
+                next<N - 1>();
+            }
+            else
+            {
+                std::ranges::advance(it, std::ranges::end(base));
+                changed_ = dimensions;
+            }
+        }
+
+        template <std::size_t N, typename F>
+        constexpr void visit_change(F& f) const
+        {
+            auto const& it{ std::get<N>(currents_) };
+            auto const old{ forward_[N] ? std::ranges::prev(it) : std::ranges::next(it) };
+
+            std::invoke(f, std::integral_constant<std::size_t, N>{}, *old, *it);
+        }
+
+        template <typename F, std::size_t... Is>
+        constexpr void visit_change(F& f, std::index_sequence<Is...>) const
+        {
+            static_cast<void>(((changed_ == Is ? (visit_change<Is>(f), true) : false) || ...));
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<std::ranges::range_reference_t<constify<Ts>>...>;
+        using value_type = std::tuple<std::ranges::range_value_t<constify<Ts>>...>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr explicit iterator(begin_tag_t, constify<std::tuple<Ts...>>* bases)
+            : bases_{ bases }, currents_{ std::apply([](auto&&... bs) { return std::make_tuple(std::ranges::begin(bs)...); }, *bases) }
+        {
+            forward_.fill(true);
+
+            //An empty base anywhere makes the whole product empty
+            if (std::apply([](auto const&... bs) { return (std::ranges::empty(bs) || ...); }, *bases_))
+            {
+                std::ranges::advance(std::get<0>(currents_), std::ranges::end(std::get<0>(*bases_)));
+            }
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && (std::convertible_to<std::ranges::iterator_t<Ts>, std::ranges::iterator_t<constify<Ts>>> && ...)
+            : bases_{ i.bases_ }, currents_{ std::move(i.currents_) }, forward_{ i.forward_ }, changed_{ i.changed_ }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return std::apply([](auto const&... currents) {
+                return reference{ *currents... };
+                }, currents_);
+        }
+
+        //Index of the base moved by the last increment, or the number of bases before the first one
+        constexpr std::size_t changed_dimension() const
+        {
+            return changed_;
+        }
+
+        //Calls f(std::integral_constant<std::size_t, N>{}, old_element, new_element) for the base N moved by the
+        //last increment, so f can be a generic lambda that knows the element type of that base
+        //Does nothing before the first increment
+        template <typename F>
+        constexpr void visit_change(F f) const
+        {
+            visit_change(f, std::index_sequence_for<Ts...>{});
+        }
+
+        constexpr iterator& operator++()
+        {
+            next();
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            next();
+
+            return temp;
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+            requires (std::equality_comparable<std::ranges::iterator_t<constify<Ts>>> && ...)
+        {
+            return x.currents_ == y.currents_;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t const&)
+        {
+            return std::get<0>(x.currents_) == std::ranges::end(std::get<0>(*x.bases_));
+        }
+
+        friend class iterator<!Const>;
+    };
+
+public:
+    gray_cartesian_product_view() = default;
+
+    explicit gray_cartesian_product_view(Ts... bases)
+        : bases_(std::move(bases)...)
+    {
+
+    }
+
+    constexpr auto begin()
+        requires (!(simple_view<Ts> && ...))
+    {
+        return iterator<false>(begin_tag, std::addressof(bases_));
+    }
+
+    constexpr auto begin() const
+        requires (std::ranges::bidirectional_range<const Ts> && ...)
+    {
+        return iterator<true>(begin_tag, std::addressof(bases_));
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+
+    constexpr auto size() requires (std::ranges::sized_range<Ts> && ...)
+    {
+        return std::apply([](auto&&... bases) {
+            using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
+            return (static_cast<size_type>(std::ranges::size(bases)) * ...);
+            }, bases_);
+    }
+
+    constexpr auto size() const requires (std::ranges::sized_range<const Ts> && ...)
+    {
+        return std::apply([](auto&&... bases) {
+            using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
+            return (static_cast<size_type>(std::ranges::size(bases)) * ...);
+            }, bases_);
+    }
+};
+
+template <typename... Ts>
+gray_cartesian_product_view(Ts&&...)->gray_cartesian_product_view<std::views::all_t<Ts>...>;
+
+namespace views
+{
+    namespace detail
+    {
+        class gray_cartesian_product_fn
+        {
+        public:
+            template <std::ranges::viewable_range... Ts>
+            constexpr auto operator()(Ts&&... ts) const
+            {
+                return gray_cartesian_product_view{ std::views::all(std::forward<Ts>(ts))... };
+            }
+        };
+    }
+
+    inline constexpr detail::gray_cartesian_product_fn gray_cartesian_product;
+}
@@ -0,0 +1,102 @@
+#include "gray_cartesian_product.h"
+#include <algorithm>
+#include <array>
+#include <catch.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <set>
+#include <vector>
+
+namespace
+{
+	//Elements equal to their position, so a step of one element is a step of one in value
+	std::vector<int> positions(int count)
+	{
+		std::vector<int> out(count);
+
+		for (int i{ 0 }; i < count; ++i)
+		{
+			out[i] = i;
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("gray_cartesian_product moves one base by one element per step")
+{
+	for (auto const& sizes : { std::array{ 3, 2, 4 }, std::array{ 1, 3, 1 }, std::array{ 2, 2, 2 }, std::array{ 1, 1, 1 } })
+	{
+		auto const a{ positions(sizes[0]) };
+		auto const b_positions{ positions(sizes[1]) };
+		std::list<int> const b(std::begin(b_positions), std::end(b_positions));
+		auto const c{ positions(sizes[2]) };
+
+		auto const view{ views::gray_cartesian_product(a, b, c) };
+		std::set<std::array<int, 3>> visited;
+		std::array<int, 3> previous{};
+
+		for (auto it{ view.begin() }; it != view.end(); ++it)
+		{
+			auto const [x, y, z] { *it };
+			std::array const current{ x, y, z };
+
+			REQUIRE(visited.insert(current).second);
+
+			if (visited.size() == 1)
+			{
+				REQUIRE(current == std::array{ 0, 0, 0 });
+				REQUIRE(it.changed_dimension() == 3);
+			}
+			else
+			{
+				std::size_t changes{ 0 };
+
+				for (std::size_t d{ 0 }; d < 3; ++d)
+				{
+					if (current[d] != previous[d])
+					{
+						++changes;
+						REQUIRE(std::abs(current[d] - previous[d]) == 1);
+						REQUIRE(it.changed_dimension() == d);
+					}
+				}
+
+				REQUIRE(changes == 1);
+
+				it.visit_change([&](auto d, int old_value, int new_value) {
+					REQUIRE(old_value == previous[d]);
+					REQUIRE(new_value == current[d]);
+				});
+			}
+
+			previous = current;
+		}
+
+		REQUIRE(visited.size() == view.size());
+	}
+}
+
+TEST_CASE("gray_cartesian_product follows the documented order")
+{
+	std::vector const a{ 0, 1 };
+	std::vector const b{ 0, 1, 2 };
+	std::vector<std::array<int, 2>> visited;
+
+	for (auto const& [x, y] : views::gray_cartesian_product(a, b))
+	{
+		visited.push_back({ x, y });
+	}
+
+	REQUIRE(visited == std::vector<std::array<int, 2>>{ { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 2 }, { 1, 1 }, { 1, 0 } });
+}
+
+TEST_CASE("gray_cartesian_product with an empty base is empty")
+{
+	std::vector const a{ 0, 1 };
+	std::vector<int> const empty;
+
+	REQUIRE(views::gray_cartesian_product(a, empty).begin() == views::gray_cartesian_product(a, empty).end());
+	REQUIRE(views::gray_cartesian_product(empty, a).begin() == views::gray_cartesian_product(empty, a).end());
+}
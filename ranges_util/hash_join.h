@@ -0,0 +1,492 @@
+#pragma once
+
+#include "common.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Equi-join of two ranges yielding the same std::tuple of references as views::cartesian_product(a, b),
+//so views::cartesian_product(a, b) | std::views::filter(key_a(a) == key_b(b)) can be replaced as is
+//hash_join builds an open addressing table over b and streams a: O(|a| + |b| + matches)
+//Pairs come in the order of cartesian_product | filter: by element of a, then by element of b
+//With any_order_tag the table is built over the smaller side instead, which saves memory when a is the smaller one,
+//but then the pairs come grouped by element of b
+//sort_merge_join needs both ranges sorted by key and costs no extra memory; pairs come in key order
+namespace detail
+{
+    template <typename A, typename B, typename KA, typename KB>
+    using join_key_t = std::common_type_t<
+        std::remove_cvref_t<std::invoke_result_t<KA&, std::ranges::range_reference_t<A const>>>,
+        std::remove_cvref_t<std::invoke_result_t<KB&, std::ranges::range_reference_t<B const>>>>;
+}
+
+template <std::ranges::view A, std::ranges::view B, typename KA, typename KB>
+requires std::ranges::forward_range<A const> && std::ranges::forward_range<B const> && std::is_object_v<KA> && std::is_object_v<KB>
+class hash_join_view
+    : public std::ranges::view_interface<hash_join_view<A, B, KA, KB>>
+{
+    using key_type = detail::join_key_t<A, B, KA, KB>;
+    using a_iterator = std::ranges::iterator_t<A const>;
+    using b_iterator = std::ranges::iterator_t<B const>;
+
+    static constexpr auto npos = static_cast<std::size_t>(-1);
+
+    //Open addressing table over the positions of one side
+    //Equal keys share a slot, their positions are chained through next_ in the order of the side
+    struct table
+    {
+        struct slot
+        {
+            std::size_t hash;
+            std::size_t head = npos;
+        };
+
+        bool built_on_a = false;
+        std::vector<a_iterator> a_items;
+        std::vector<b_iterator> b_items;
+        std::vector<std::size_t> next;
+        std::vector<slot> slots;
+        std::size_t mask = 0;
+        //Home slot is the top bits of the hash times 2^64 / phi, so that keys std::hash leaves clustered,
+        //like multiples of a power of two under an identity hash, still spread over the whole table
+        int shift = 63;
+
+        std::size_t home(std::size_t hash) const
+        {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift);
+        }
+    };
+
+    A a_;
+    B b_;
+    KA key_a_;
+    KB key_b_;
+    bool any_order_ = false;
+    std::shared_ptr<table const> table_;
+
+    key_type key_of_item(table const& t, std::size_t i) const
+    {
+        return t.built_on_a ? key_type(std::invoke(key_a_, *t.a_items[i])) : key_type(std::invoke(key_b_, *t.b_items[i]));
+    }
+
+    //Head of the chain of positions with the given key, or npos
+    std::size_t find(key_type const& key) const
+    {
+        auto const& t{ *table_ };
+        auto const hash{ std::hash<key_type>{}(key) };
+
+        for (auto s{ t.home(hash) }; ; s = (s + 1) & t.mask)
+        {
+            auto const& slot{ t.slots[s] };
+
+            if (slot.head == npos)
+            {
+                return npos;
+            }
+
+            if (slot.hash == hash && key_of_item(t, slot.head) == key)
+            {
+                return slot.head;
+            }
+        }
+    }
+
+    template <typename R>
+    static auto positions_of(R const& r)
+    {
+        std::vector<std::ranges::iterator_t<R const>> items;
+
+        if constexpr (std::ranges::sized_range<R const>)
+        {
+            items.reserve(std::ranges::size(r));
+        }
+
+        for (auto it{ std::ranges::begin(r) }; it != std::ranges::end(r); ++it)
+        {
+            items.push_back(it);
+        }
+
+        return items;
+    }
+
+    std::shared_ptr<table const> build() const
+    {
+        auto t{ std::make_shared<table>() };
+
+        //Without sizes both sides would have to be walked to compare them, so b is built on then
+        if constexpr (std::ranges::sized_range<A const> && std::ranges::sized_range<B const>)
+        {
+            t->built_on_a = any_order_ && std::ranges::size(a_) < std::ranges::size(b_);
+        }
+
+        if (t->built_on_a)
+        {
+            t->a_items = positions_of(a_);
+        }
+        else
+        {
+            t->b_items = positions_of(b_);
+        }
+
+        auto const count{ t->built_on_a ? t->a_items.size() : t->b_items.size() };
+
+        //At most half full keeps the probe sequences short
+        t->slots.resize(std::bit_ceil(count * 2 + 2));
+        t->mask = t->slots.size() - 1;
+        t->shift = 64 - std::countr_zero(t->slots.size());
+        t->next.assign(count, npos);
+
+        //Insert back to front so that prepending to a chain leaves it in the order of the side
+        for (auto i{ count }; i-- > 0;)
+        {
+            auto const key{ key_of_item(*t, i) };
+            auto const hash{ std::hash<key_type>{}(key) };
+            auto s{ t->home(hash) };
+
+            while (t->slots[s].head != npos && !(t->slots[s].hash == hash && key_of_item(*t, t->slots[s].head) == key))
+            {
+                s = (s + 1) & t->mask;
+            }
+
+            t->next[i] = t->slots[s].head;
+            t->slots[s] = { hash, i };
+        }
+
+        return t;
+    }
+
+    class iterator
+    {
+        hash_join_view const* parent_ = nullptr;
+        a_iterator a_{};
+        b_iterator b_{};
+        //Position of the current match on the built side
+        std::size_t match_ = npos;
+
+        bool streamed_at_end() const
+        {
+            return parent_->table_->built_on_a ? b_ == std::ranges::end(parent_->b_) : a_ == std::ranges::end(parent_->a_);
+        }
+
+        //Starting at the current streamed element, find the first one with at least one match
+        void settle()
+        {
+            auto const& t{ *parent_->table_ };
+
+            if (t.built_on_a)
+            {
+                for (; b_ != std::ranges::end(parent_->b_); ++b_)
+                {
+                    if ((match_ = parent_->find(key_type(std::invoke(parent_->key_b_, *b_)))) != npos)
+                    {
+                        return;
+                    }
+                }
+            }
+            else
+            {
+                for (; a_ != std::ranges::end(parent_->a_); ++a_)
+                {
+                    if ((match_ = parent_->find(key_type(std::invoke(parent_->key_a_, *a_)))) != npos)
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<std::ranges::range_reference_t<A const>, std::ranges::range_reference_t<B const>>;
+        using value_type = std::tuple<std::ranges::range_value_t<A const>, std::ranges::range_value_t<B const>>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(hash_join_view const* parent)
+            : parent_{ parent }, a_{ std::ranges::begin(parent->a_) }, b_{ std::ranges::begin(parent->b_) }
+        {
+            settle();
+        }
+
+        reference operator*() const
+        {
+            auto const& t{ *parent_->table_ };
+
+            return t.built_on_a ? reference{ *t.a_items[match_], *b_ } : reference{ *a_, *t.b_items[match_] };
+        }
+
+        iterator& operator++()
+        {
+            match_ = parent_->table_->next[match_];
+
+            if (match_ == npos)
+            {
+                if (parent_->table_->built_on_a)
+                {
+                    ++b_;
+                }
+                else
+                {
+                    ++a_;
+                }
+
+                settle();
+            }
+
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        friend bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.a_ == y.a_ && x.b_ == y.b_ && x.match_ == y.match_;
+        }
+
+        //A default constructed iterator, which begin() hands out for a view without a table, is at the end
+        friend bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return !x.parent_ || x.streamed_at_end();
+        }
+    };
+
+public:
+    hash_join_view() = default;
+
+    hash_join_view(A a, B b, KA key_a, KB key_b)
+        : a_{ std::move(a) }, b_{ std::move(b) }, key_a_{ std::move(key_a) }, key_b_{ std::move(key_b) }
+    {
+        table_ = build();
+    }
+
+    hash_join_view(A a, B b, KA key_a, KB key_b, any_order_tag_t)
+        : a_{ std::move(a) }, b_{ std::move(b) }, key_a_{ std::move(key_a) }, key_b_{ std::move(key_b) }, any_order_{ true }
+    {
+        table_ = build();
+    }
+
+    //A default constructed view has no table and joins nothing
+    auto begin() const
+    {
+        return table_ ? iterator{ this } : iterator{};
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+};
+
+template <typename A, typename B, typename KA, typename KB>
+hash_join_view(A&&, B&&, KA, KB)->hash_join_view<std::views::all_t<A>, std::views::all_t<B>, KA, KB>;
+
+template <typename A, typename B, typename KA, typename KB>
+hash_join_view(A&&, B&&, KA, KB, any_order_tag_t)->hash_join_view<std::views::all_t<A>, std::views::all_t<B>, KA, KB>;
+
+//Both ranges must be sorted by key with operator<
+template <std::ranges::view A, std::ranges::view B, typename KA, typename KB>
+requires std::ranges::forward_range<A const> && std::ranges::forward_range<B const> && std::is_object_v<KA> && std::is_object_v<KB>
+class sort_merge_join_view
+    : public std::ranges::view_interface<sort_merge_join_view<A, B, KA, KB>>
+{
+    using key_type = detail::join_key_t<A, B, KA, KB>;
+
+    A a_;
+    B b_;
+    KA key_a_;
+    KB key_b_;
+
+    class iterator
+    {
+        sort_merge_join_view const* parent_ = nullptr;
+        std::ranges::iterator_t<A const> a_{};
+        std::ranges::iterator_t<B const> b_{};
+        //[run_begin_, run_end_) holds every element of b with the key of *a_
+        std::ranges::iterator_t<B const> run_begin_{};
+        std::ranges::iterator_t<B const> run_end_{};
+
+        key_type key_a() const
+        {
+            return key_type(std::invoke(parent_->key_a_, *a_));
+        }
+
+        key_type key_b(std::ranges::iterator_t<B const> const& it) const
+        {
+            return key_type(std::invoke(parent_->key_b_, *it));
+        }
+
+        //Advance a_ and run_begin_ in lockstep until their keys meet, then find the end of the run in b
+        void settle()
+        {
+            auto const a_end{ std::ranges::end(parent_->a_) };
+            auto const b_end{ std::ranges::end(parent_->b_) };
+
+            while (a_ != a_end && run_begin_ != b_end)
+            {
+                auto const ka{ key_a() };
+                auto const kb{ key_b(run_begin_) };
+
+                if (ka < kb)
+                {
+                    ++a_;
+                }
+                else if (kb < ka)
+                {
+                    ++run_begin_;
+                }
+                else
+                {
+                    run_end_ = std::ranges::next(run_begin_);
+
+                    while (run_end_ != b_end && !(ka < key_b(run_end_)))
+                    {
+                        ++run_end_;
+                    }
+
+                    b_ = run_begin_;
+
+                    return;
+                }
+            }
+
+            std::ranges::advance(a_, a_end);
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<std::ranges::range_reference_t<A const>, std::ranges::range_reference_t<B const>>;
+        using value_type = std::tuple<std::ranges::range_value_t<A const>, std::ranges::range_value_t<B const>>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(sort_merge_join_view const* parent)
+            : parent_{ parent }, a_{ std::ranges::begin(parent->a_) }, run_begin_{ std::ranges::begin(parent->b_) }
+        {
+            settle();
+        }
+
+        reference operator*() const
+        {
+            return { *a_, *b_ };
+        }
+
+        iterator& operator++()
+        {
+            if (++b_ != run_end_)
+            {
+                return *this;
+            }
+
+            //Elements of a with the same key join the same run of b again
+            auto const previous_key{ key_a() };
+
+            if (++a_ != std::ranges::end(parent_->a_) && !(previous_key < key_a()))
+            {
+                b_ = run_begin_;
+
+                return *this;
+            }
+
+            run_begin_ = run_end_;
+            settle();
+
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        bool at_end() const
+        {
+            return a_ == std::ranges::end(parent_->a_);
+        }
+
+        friend bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.a_ == y.a_ && (x.at_end() || x.b_ == y.b_);
+        }
+
+        friend bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.at_end();
+        }
+    };
+
+public:
+    sort_merge_join_view() = default;
+
+    sort_merge_join_view(A a, B b, KA key_a, KB key_b)
+        : a_{ std::move(a) }, b_{ std::move(b) }, key_a_{ std::move(key_a) }, key_b_{ std::move(key_b) }
+    {
+
+    }
+
+    auto begin() const
+    {
+        return iterator{ this };
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+};
+
+template <typename A, typename B, typename KA, typename KB>
+sort_merge_join_view(A&&, B&&, KA, KB)->sort_merge_join_view<std::views::all_t<A>, std::views::all_t<B>, KA, KB>;
+
+namespace views
+{
+    namespace detail
+    {
+        struct hash_join_fn
+        {
+            template <std::ranges::viewable_range A, std::ranges::viewable_range B, typename KA, typename KB>
+            auto operator()(A&& a, B&& b, KA key_a, KB key_b) const
+            {
+                return hash_join_view(std::forward<A>(a), std::forward<B>(b), std::move(key_a), std::move(key_b));
+            }
+
+            template <std::ranges::viewable_range A, std::ranges::viewable_range B, typename KA, typename KB>
+            auto operator()(A&& a, B&& b, KA key_a, KB key_b, any_order_tag_t) const
+            {
+                return hash_join_view(std::forward<A>(a), std::forward<B>(b), std::move(key_a), std::move(key_b), any_order_tag);
+            }
+        };
+
+        struct sort_merge_join_fn
+        {
+            template <std::ranges::viewable_range A, std::ranges::viewable_range B, typename KA, typename KB>
+            auto operator()(A&& a, B&& b, KA key_a, KB key_b) const
+            {
+                return sort_merge_join_view(std::forward<A>(a), std::forward<B>(b), std::move(key_a), std::move(key_b));
+            }
+        };
+    }
+
+    constexpr inline detail::hash_join_fn hash_join;
+    constexpr inline detail::sort_merge_join_fn sort_merge_join;
+}
@@ -0,0 +1,177 @@
+#include "hash_join.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	//What cartesian_product | filter yields, as (a index, b index) pairs
+	template <typename A, typename B, typename KA, typename KB>
+	std::vector<std::pair<int, int>> filtered_product(A const& a, B const& b, KA key_a, KB key_b)
+	{
+		std::vector<std::pair<int, int>> out;
+
+		for (int i{ 0 }; i < static_cast<int>(std::size(a)); ++i)
+		{
+			for (int j{ 0 }; j < static_cast<int>(std::size(b)); ++j)
+			{
+				if (key_a(a[i]) == key_b(b[j]))
+				{
+					out.emplace_back(i, j);
+				}
+			}
+		}
+
+		return out;
+	}
+
+	//Elements carry their index so that the pairs can be compared by position
+	using item = std::pair<int, int>;
+
+	std::vector<std::pair<int, int>> indices(auto&& joined)
+	{
+		std::vector<std::pair<int, int>> out;
+
+		for (auto const& [x, y] : joined)
+		{
+			out.emplace_back(x.second, y.second);
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("hash_join matches every duplicate key in the order of cartesian_product | filter")
+{
+	std::vector<item> const a{ { 1, 0 }, { 2, 1 }, { 1, 2 }, { 3, 3 } };
+	std::vector<item> const b{ { 1, 0 }, { 4, 1 }, { 1, 2 }, { 2, 3 }, { 1, 4 }, { 5, 5 }, { 3, 6 } };
+	auto const key{ [](item const& e) { return e.first; } };
+
+	REQUIRE(indices(views::hash_join(a, b, key, key)) == filtered_product(a, b, key, key));
+}
+
+TEST_CASE("hash_join keeps the order of a when a is the smaller side")
+{
+	std::vector<item> const a{ { 3, 0 }, { 1, 1 } };
+	std::vector<item> const b{ { 1, 0 }, { 3, 1 }, { 1, 2 }, { 3, 3 }, { 2, 4 } };
+	auto const key{ [](item const& e) { return e.first; } };
+
+	REQUIRE(indices(views::hash_join(a, b, key, key)) == std::vector<std::pair<int, int>>{ { 0, 1 }, { 0, 3 }, { 1, 0 }, { 1, 2 } });
+}
+
+TEST_CASE("hash_join with any_order_tag builds over the smaller side and groups by b")
+{
+	std::vector<item> const a{ { 3, 0 }, { 1, 1 } };
+	std::vector<item> const b{ { 1, 0 }, { 3, 1 }, { 1, 2 }, { 3, 3 }, { 2, 4 } };
+	auto const key{ [](item const& e) { return e.first; } };
+
+	REQUIRE(indices(views::hash_join(a, b, key, key, any_order_tag)) == std::vector<std::pair<int, int>>{ { 1, 0 }, { 0, 1 }, { 1, 2 }, { 0, 3 } });
+}
+
+TEST_CASE("default constructed hash_join is empty")
+{
+	hash_join_view<std::ranges::iota_view<int, int>, std::ranges::iota_view<int, int>, std::identity, std::identity> const view{};
+
+	REQUIRE(view.begin() == view.end());
+}
+
+TEST_CASE("hash_join with an empty side is empty")
+{
+	std::vector<int> const empty;
+	std::vector<int> const some{ 1, 2, 3 };
+	std::list<int> const none;
+	auto const is_empty{ [](auto const& joined) { return joined.begin() == joined.end(); } };
+
+	REQUIRE(is_empty(views::hash_join(empty, some, std::identity{}, std::identity{})));
+	REQUIRE(is_empty(views::hash_join(some, empty, std::identity{}, std::identity{})));
+	REQUIRE(is_empty(views::hash_join(empty, empty, std::identity{}, std::identity{})));
+	REQUIRE(is_empty(views::hash_join(some, empty, std::identity{}, std::identity{}, any_order_tag)));
+	REQUIRE(is_empty(views::hash_join(some, std::ranges::subrange(none.begin(), none.end()), std::identity{}, std::identity{})));
+	REQUIRE(is_empty(views::hash_join(some, std::vector{ 4, 5 }, std::identity{}, std::identity{})));
+}
+
+TEST_CASE("hash_join over keys that are all multiples of 4096")
+{
+	//std::hash is the identity for integers in some standard libraries, so these would all share the low bits
+	std::vector<std::size_t> a(1 << 14), b;
+
+	for (std::size_t i{ 0 }; i < std::size(a); ++i)
+	{
+		a[i] = i * 4096;
+	}
+
+	for (std::size_t i{ 0 }; i < std::size(a); i += 3)
+	{
+		b.push_back(a[std::size(a) - 1 - i]);
+		b.push_back(a[std::size(a) - 1 - i]);
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> expected;
+
+	for (auto const x : a)
+	{
+		for (std::size_t n{ 0 }; n < (x / 4096 % 3 == (std::size(a) - 1) % 3 ? 2u : 0u); ++n)
+		{
+			expected.emplace_back(x, x);
+		}
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> joined;
+
+	for (auto const& [x, y] : views::hash_join(a, b, std::identity{}, std::identity{}))
+	{
+		joined.emplace_back(x, y);
+	}
+
+	REQUIRE(joined == expected);
+}
+
+TEST_CASE("sort_merge_join matches cartesian_product | filter sorted by key")
+{
+	auto const key{ [](item const& e) { return e.first; } };
+
+	//Numbers every element by its position so that pairs are compared by position
+	auto const items{ [](std::vector<int> const& keys) {
+		std::vector<item> out;
+
+		for (auto const k : keys)
+		{
+			out.emplace_back(k, static_cast<int>(std::size(out)));
+		}
+
+		return out;
+	} };
+
+	std::vector<std::pair<std::vector<int>, std::vector<int>>> const cases{
+		//Duplicates on both sides, unmatched keys before, between and after the runs
+		{ { 1, 1, 2, 4, 4, 4, 7 }, { 0, 1, 1, 1, 4, 4, 7, 7, 9 } },
+		//Matching runs at both ends of both sides
+		{ { 1, 1, 5, 5 }, { 1, 5, 5, 5 } },
+		{ { 3 }, { 3, 3, 3 } },
+		{ { 3, 3, 3 }, { 3 } },
+		//Nothing matches
+		{ { 1, 3, 5 }, { 0, 2, 4, 6 } },
+		//Empty sides
+		{ {}, { 1, 2 } },
+		{ { 1, 2 }, {} },
+		{ {}, {} } };
+
+	for (auto const& [keys_a, keys_b] : cases)
+	{
+		auto const a{ items(keys_a) };
+		auto const b{ items(keys_b) };
+		auto expected{ filtered_product(a, b, key, key) };
+
+		std::ranges::stable_sort(expected, {}, [&](std::pair<int, int> const& p) { return a[p.first].first; });
+
+		REQUIRE(indices(views::sort_merge_join(a, b, key, key)) == expected);
+
+		std::list const list_b(std::begin(b), std::end(b));
+
+		REQUIRE(indices(views::sort_merge_join(a, std::ranges::subrange(list_b.begin(), list_b.end()), key, key)) == expected);
+	}
+}
@@ -0,0 +1,467 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Operation counters for checking what a pipeline really does, e.g. how often chunk_by calls its predicate
+//v | views::instrument("source") | views::chunk_by(instrumented_predicate("same", std::equal_to<>{})) counts
+//every iterator operation the chunk_by stage performs on its base and every predicate call, under the given names
+//The counters are plain integers, so instrumented pipelines must not be shared between threads
+struct instrument_stats
+{
+    std::string name;
+    std::size_t increments = 0;
+    std::size_t decrements = 0;
+    //operator+= / operator-= and iterator differences
+    std::size_t jumps = 0;
+    std::size_t dereferences = 0;
+    //Iterator against iterator or sentinel, including the end test of every loop step
+    std::size_t comparisons = 0;
+    std::size_t predicate_calls = 0;
+    std::size_t key_calls = 0;
+    //Time spent inside the counted operations, which includes the stages before this one
+    std::chrono::nanoseconds elapsed{};
+};
+
+//Named stages in the order they were first used
+class instrument_registry
+{
+    std::vector<std::shared_ptr<instrument_stats>> stages_;
+
+public:
+    //The stage with this name, created on first use, so the same name always counts into the same stats
+    std::shared_ptr<instrument_stats> stage(std::string_view name)
+    {
+        auto const it{ std::ranges::find(stages_, name, [](auto const& stats) { return std::string_view{ stats->name }; }) };
+
+        if (it != std::ranges::end(stages_))
+        {
+            return *it;
+        }
+
+        auto stats{ std::make_shared<instrument_stats>() };
+
+        stats->name = name;
+        stages_.push_back(stats);
+
+        return stats;
+    }
+
+    instrument_stats const& operator[](std::string_view name)
+    {
+        return *stage(name);
+    }
+
+    //Zero every counter, keeping views that are still alive attached to their stage
+    void reset()
+    {
+        for (auto& stats : stages_)
+        {
+            auto name{ std::move(stats->name) };
+
+            *stats = instrument_stats{};
+            stats->name = std::move(name);
+        }
+    }
+
+    void report(std::ostream& out) const
+    {
+        out << std::left << std::setw(24) << "stage" << std::right
+            << std::setw(12) << "++" << std::setw(12) << "--" << std::setw(12) << "+=/-"
+            << std::setw(12) << "*" << std::setw(12) << "==" << std::setw(12) << "pred"
+            << std::setw(12) << "key" << std::setw(14) << "us" << '\n';
+
+        for (auto const& stats : stages_)
+        {
+            out << std::left << std::setw(24) << stats->name << std::right
+                << std::setw(12) << stats->increments << std::setw(12) << stats->decrements << std::setw(12) << stats->jumps
+                << std::setw(12) << stats->dereferences << std::setw(12) << stats->comparisons << std::setw(12) << stats->predicate_calls
+                << std::setw(12) << stats->key_calls
+                << std::setw(14) << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::micro>(stats->elapsed).count() << '\n';
+        }
+    }
+};
+
+inline instrument_registry& instruments()
+{
+    static instrument_registry registry;
+
+    return registry;
+}
+
+namespace detail
+{
+    //Counts one operation and adds the time it took
+    template <typename F>
+    decltype(auto) instrumented_call(instrument_stats& stats, std::size_t instrument_stats::* counter, F&& f)
+    {
+        struct timer
+        {
+            instrument_stats& stats;
+            std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+
+            ~timer()
+            {
+                stats.elapsed += std::chrono::steady_clock::now() - start;
+            }
+        };
+
+        ++(stats.*counter);
+
+        timer const t{ stats };
+
+        return std::forward<F>(f)();
+    }
+
+    //Callable wrapper counting its calls into one counter of a stage
+    //Copies share the counters, so algorithms that copy their predicate (std::not_fn, std::adjacent_find, ...) are counted too
+    template <typename F>
+    class instrumented_callable
+    {
+        F f_;
+        std::shared_ptr<instrument_stats> stats_;
+        std::size_t instrument_stats::* counter_ = nullptr;
+
+    public:
+        instrumented_callable(F f, std::shared_ptr<instrument_stats> stats, std::size_t instrument_stats::* counter)
+            : f_{ std::move(f) }, stats_{ std::move(stats) }, counter_{ counter }
+        {
+
+        }
+
+        template <typename... Args>
+        requires std::invocable<F const&, Args...>
+        decltype(auto) operator()(Args&&... args) const
+        {
+            return instrumented_call(*stats_, counter_, [&]() -> decltype(auto) { return std::invoke(f_, std::forward<Args>(args)...); });
+        }
+    };
+}
+
+//pred counting into the predicate_calls of the named stage
+template <typename F>
+auto instrumented_predicate(std::string_view name, F f)
+{
+    return detail::instrumented_callable<F>{ std::move(f), instruments().stage(name), &instrument_stats::predicate_calls };
+}
+
+//key function counting into the key_calls of the named stage
+template <typename F>
+auto instrumented_key(std::string_view name, F f)
+{
+    return detail::instrumented_callable<F>{ std::move(f), instruments().stage(name), &instrument_stats::key_calls };
+}
+
+//Passes its base through unchanged, with the same iterator category, and counts every operation done on it
+template <std::ranges::input_range V>
+requires std::ranges::view<V>
+class instrument_view
+    : public std::ranges::view_interface<instrument_view<V>>
+{
+    V base_;
+    std::shared_ptr<instrument_stats> stats_;
+
+    template <bool Const>
+    class sentinel;
+
+    template <bool Const>
+    class iterator
+    {
+        using Base = std::conditional_t<Const, V const, V>;
+
+        std::ranges::iterator_t<Base> current_{};
+        instrument_stats* stats_ = nullptr;
+
+        template <typename F>
+        decltype(auto) count(std::size_t instrument_stats::* counter, F&& f) const
+        {
+            return detail::instrumented_call(*stats_, counter, std::forward<F>(f));
+        }
+
+    public:
+        using iterator_category = common_iterator_category<Base>;
+        using reference = std::ranges::range_reference_t<Base>;
+        using value_type = std::ranges::range_value_t<Base>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        constexpr explicit iterator(std::ranges::iterator_t<Base> current, instrument_stats* stats)
+            : current_{ std::move(current) }, stats_{ stats }
+        {
+
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
+            : current_{ std::move(i.current_) }, stats_{ i.stats_ }
+        {
+
+        }
+
+        constexpr std::ranges::iterator_t<Base> const& base() const&
+        {
+            return current_;
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return count(&instrument_stats::dereferences, [&]() -> decltype(auto) { return *current_; });
+        }
+
+        constexpr iterator& operator++()
+        {
+            count(&instrument_stats::increments, [&] { ++current_; });
+
+            return *this;
+        }
+
+        constexpr void operator++(int) requires (!std::ranges::forward_range<Base>)
+        {
+            ++*this;
+        }
+
+        constexpr iterator operator++(int) requires std::ranges::forward_range<Base>
+        {
+            auto temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator--() requires std::ranges::bidirectional_range<Base>
+        {
+            count(&instrument_stats::decrements, [&] { --current_; });
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires std::ranges::bidirectional_range<Base>
+        {
+            auto temp{ *this };
+
+            --*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type n) requires std::ranges::random_access_range<Base>
+        {
+            count(&instrument_stats::jumps, [&] { current_ += n; });
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type n) requires std::ranges::random_access_range<Base>
+        {
+            count(&instrument_stats::jumps, [&] { current_ -= n; });
+
+            return *this;
+        }
+
+        constexpr decltype(auto) operator[](difference_type n) const requires std::ranges::random_access_range<Base>
+        {
+            return count(&instrument_stats::dereferences, [&]() -> decltype(auto) { return current_[n]; });
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y) requires std::equality_comparable<std::ranges::iterator_t<Base>>
+        {
+            return x.count(&instrument_stats::comparisons, [&] { return x.current_ == y.current_; });
+        }
+
+        friend constexpr auto operator<=>(iterator const& x, iterator const& y) requires std::ranges::random_access_range<Base> && std::three_way_comparable<std::ranges::iterator_t<Base>>
+        {
+            return x.count(&instrument_stats::comparisons, [&] { return x.current_ <=> y.current_; });
+        }
+
+        friend constexpr iterator operator+(iterator x, difference_type n) requires std::ranges::random_access_range<Base>
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator+(difference_type n, iterator x) requires std::ranges::random_access_range<Base>
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator-(iterator x, difference_type n) requires std::ranges::random_access_range<Base>
+        {
+            return x -= n;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y) requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return x.count(&instrument_stats::jumps, [&] { return x.current_ - y.current_; });
+        }
+
+        friend class iterator<!Const>;
+        friend class sentinel<Const>;
+    };
+
+    //Only needed when the base is not a common range
+    template <bool Const>
+    class sentinel
+    {
+        using Base = std::conditional_t<Const, V const, V>;
+
+        std::ranges::sentinel_t<Base> end_{};
+
+    public:
+        sentinel() = default;
+        constexpr explicit sentinel(std::ranges::sentinel_t<Base> end)
+            : end_{ std::move(end) }
+        {
+
+        }
+
+        constexpr sentinel(sentinel<!Const> s) requires Const && std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base>>
+            : end_{ std::move(s.end_) }
+        {
+
+        }
+
+        //Members rather than friends, so they can reach the base iterator in place; input iterators such as
+        //std::views::istream's cannot be copied out
+        constexpr bool equal(iterator<Const> const& x) const
+        {
+            return x.count(&instrument_stats::comparisons, [&] { return x.current_ == end_; });
+        }
+
+        constexpr std::ranges::range_difference_t<Base> distance_from(iterator<Const> const& x) const
+        {
+            return x.count(&instrument_stats::jumps, [&] { return end_ - x.current_; });
+        }
+
+        friend constexpr bool operator==(iterator<Const> const& x, sentinel const& y)
+        {
+            return y.equal(x);
+        }
+
+        friend constexpr std::ranges::range_difference_t<Base> operator-(iterator<Const> const& x, sentinel const& y)
+            requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return -y.distance_from(x);
+        }
+
+        friend constexpr std::ranges::range_difference_t<Base> operator-(sentinel const& y, iterator<Const> const& x)
+            requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return y.distance_from(x);
+        }
+
+        friend class sentinel<!Const>;
+    };
+
+    template <bool Const, typename Base>
+    static constexpr auto end_of(Base& base, instrument_stats* stats)
+    {
+        if constexpr (std::ranges::common_range<Base>)
+        {
+            return iterator<Const>(std::ranges::end(base), stats);
+        }
+        else
+        {
+            return sentinel<Const>(std::ranges::end(base));
+        }
+    }
+
+public:
+    instrument_view() = default;
+
+    instrument_view(V base, std::shared_ptr<instrument_stats> stats)
+        : base_{ std::move(base) }, stats_{ std::move(stats) }
+    {
+
+    }
+
+    constexpr auto begin() requires (!simple_view<V>)
+    {
+        return iterator<false>(std::ranges::begin(base_), stats_.get());
+    }
+
+    constexpr auto begin() const requires std::ranges::input_range<V const>
+    {
+        return iterator<true>(std::ranges::begin(base_), stats_.get());
+    }
+
+    constexpr auto end() requires (!simple_view<V>)
+    {
+        return end_of<false>(base_, stats_.get());
+    }
+
+    constexpr auto end() const requires std::ranges::input_range<V const>
+    {
+        return end_of<true>(base_, stats_.get());
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<V const>
+    {
+        return std::ranges::size(base_);
+    }
+
+    instrument_stats const& stats() const
+    {
+        return *stats_;
+    }
+
+    constexpr V base() const& requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+};
+
+namespace views
+{
+    namespace detail
+    {
+        struct instrument_closure
+        {
+            std::string name;
+
+            template <std::ranges::viewable_range R>
+            friend auto operator|(R&& r, instrument_closure const& c)
+            {
+                return instrument_view<std::views::all_t<R>>{ std::views::all(std::forward<R>(r)), instruments().stage(c.name) };
+            }
+        };
+
+        struct instrument_fn
+        {
+            instrument_closure operator()(std::string_view name) const
+            {
+                return { std::string{ name } };
+            }
+
+            template <std::ranges::viewable_range R>
+            auto operator()(R&& r, std::string_view name) const
+            {
+                return std::forward<R>(r) | instrument_closure{ std::string{ name } };
+            }
+        };
+    }
+
+    //Counts the operations the next stage performs on r, under the given stage name (see instruments().report)
+    constexpr inline detail::instrument_fn instrument;
+}
@@ -0,0 +1,186 @@
+#include "chunk_by.h"
+#include "chunk_by_key.h"
+#include "enumerate.h"
+#include "instrument.h"
+#include "stride.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <functional>
+#include <list>
+#include <sstream>
+#include <vector>
+
+TEST_CASE("instrument passes elements through")
+{
+	std::vector a{ 1, 2, 3 };
+	auto view{ a | views::instrument("pass through") };
+
+	STATIC_REQUIRE(std::ranges::random_access_range<decltype(view)>);
+	STATIC_REQUIRE(std::ranges::common_range<decltype(view)>);
+	REQUIRE(std::ranges::equal(view, a));
+}
+
+TEST_CASE("enumerate touches every element once")
+{
+	std::vector<int> a(100);
+
+	instruments().reset();
+
+	for (auto&& [index, item] : a | views::instrument("enumerate base") | views::enumerate)
+	{
+		item = static_cast<int>(index);
+	}
+
+	auto const& stats{ instruments()["enumerate base"] };
+
+	REQUIRE(stats.increments == a.size());
+	REQUIRE(stats.dereferences == a.size());
+	REQUIRE(stats.comparisons == a.size() + 1);
+}
+
+TEST_CASE("chunk_by calls its predicate n - 1 times")
+{
+	std::vector a{ 1, 1, 2, 3, 3, 3, 4, 5, 5, 6 };
+
+	instruments().reset();
+
+	std::size_t groups{ 0 };
+
+	for (auto&& group : a | views::chunk_by(instrumented_predicate("chunk_by forward", std::equal_to<>{})))
+	{
+		static_cast<void>(group);
+		++groups;
+	}
+
+	REQUIRE(groups == 6);
+	REQUIRE(instruments()["chunk_by forward"].predicate_calls == a.size() - 1);
+}
+
+TEST_CASE("chunk_by over an input range calls its predicate n - 1 times")
+{
+	std::istringstream in{ "1 1 2 3 3 3 4" };
+
+	instruments().reset();
+
+	for (auto&& group : std::views::istream<int>(in) | views::chunk_by(instrumented_predicate("chunk_by input", std::equal_to<>{})))
+	{
+		for (auto e : group)
+		{
+			static_cast<void>(e);
+		}
+	}
+
+	REQUIRE(instruments()["chunk_by input"].predicate_calls == 6);
+}
+
+TEST_CASE("instrument over a move-only input range")
+{
+	std::istringstream in{ "1 2 3 4" };
+
+	instruments().reset();
+
+	int sum{ 0 };
+
+	for (auto e : std::views::istream<int>(in) | views::instrument("istream"))
+	{
+		sum += e;
+	}
+
+	auto const& stats{ instruments()["istream"] };
+
+	REQUIRE(sum == 10);
+	REQUIRE(stats.dereferences == 4);
+	REQUIRE(stats.increments == 4);
+}
+
+TEST_CASE("chunk_by reverse walk stays linear")
+{
+	std::list a{ 1, 1, 2, 3, 3, 3, 4 };
+
+	instruments().reset();
+
+	auto view{ a | views::instrument("chunk_by list") | views::chunk_by(instrumented_predicate("chunk_by reverse", std::equal_to<>{})) };
+
+	for (auto&& group : view | std::views::reverse)
+	{
+		static_cast<void>(group);
+	}
+
+	//std::reverse_iterator dereferences by stepping a copy back, so every group is searched twice on the way back,
+	//plus the first group once for begin()
+	REQUIRE(instruments()["chunk_by reverse"].predicate_calls <= 3 * (a.size() - 1));
+	REQUIRE(instruments()["chunk_by list"].decrements <= 4 * a.size());
+}
+
+TEST_CASE("chunk_by_key calls its key a linear number of times")
+{
+	std::vector a{ 1, 1, 2, 3, 3, 3, 4 };
+
+	instruments().reset();
+
+	for (auto&& [key, group] : a | views::chunk_by_key(instrumented_key("chunk_by_key", [](int e) { return e; })))
+	{
+		static_cast<void>(key);
+	}
+
+	REQUIRE(instruments()["chunk_by_key"].key_calls <= 2 * a.size());
+}
+
+TEST_CASE("chunk_by_key over sorted runs gallops")
+{
+	constexpr std::size_t runs{ 4 };
+	constexpr std::size_t run_length{ 10000 };
+
+	std::vector<int> a;
+
+	for (std::size_t k{ 0 }; k < runs; ++k)
+	{
+		a.insert(std::end(a), run_length, static_cast<int>(k));
+	}
+
+	instruments().reset();
+
+	std::vector<std::size_t> sizes;
+
+	for (auto&& [key, group] : a | views::chunk_by_key(instrumented_key("chunk_by_key sorted", [](int e) { return e; }), sorted_tag))
+	{
+		REQUIRE(std::ranges::all_of(group, [&](int e) { return e == key; }));
+		sizes.push_back(group.size());
+	}
+
+	REQUIRE(sizes == std::vector<std::size_t>(runs, run_length));
+
+	//Galloping then binary searching a run of length m takes about 2 log2(m) key calls, 28 for m = 10000;
+	//a linear scan would take run_length per group
+	REQUIRE(instruments()["chunk_by_key sorted"].key_calls <= runs * 40);
+
+	instruments().reset();
+
+	for (auto&& [key, group] : a | views::chunk_by_key(instrumented_key("chunk_by_key unsorted", [](int e) { return e; })))
+	{
+		static_cast<void>(key);
+	}
+
+	REQUIRE(instruments()["chunk_by_key unsorted"].key_calls >= a.size());
+}
+
+TEST_CASE("stride jumps instead of stepping over random access bases")
+{
+	std::vector<int> a(100);
+
+	instruments().reset();
+
+	std::size_t count{ 0 };
+
+	for (auto e : a | views::instrument("stride base") | views::stride(10))
+	{
+		static_cast<void>(e);
+		++count;
+	}
+
+	auto const& stats{ instruments()["stride base"] };
+
+	REQUIRE(count == 10);
+	REQUIRE(stats.increments == 0);
+	REQUIRE(stats.dereferences == 10);
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "common.h"
+#include "split.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//Parallel algorithms over sized ranges whose iterators can jump with +=, such as cartesian_product_view
+//The index space [0, size()) is split into one contiguous block per thread and every worker seeks
+//straight to the start of its block, so no thread ever walks over elements it does not own
+namespace detail
+{
+    inline std::size_t default_thread_count()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    //Runs task(t, lo, hi) for every block t of [0, count) and rethrows the first exception thrown, if any
+    template <typename Task>
+    void run_partitioned(std::size_t count, std::size_t thread_count, Task&& task)
+    {
+        thread_count = std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(count, 1));
+
+        auto const block{ (count + thread_count - 1) / thread_count };
+
+        std::exception_ptr error;
+        std::atomic_flag failed;
+        std::vector<std::jthread> threads;
+
+        threads.reserve(thread_count - 1);
+
+        auto guarded{ [&](std::size_t t) {
+            try
+            {
+                task(t, std::min(t * block, count), std::min((t + 1) * block, count));
+            }
+            catch (...)
+            {
+                if (!failed.test_and_set())
+                {
+                    error = std::current_exception();
+                }
+            }
+        } };
+
+        for (std::size_t t{ 1 }; t < thread_count; ++t)
+        {
+            threads.emplace_back(guarded, t);
+        }
+
+        guarded(0);
+        threads.clear();
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template <typename R>
+    auto seek(R& r, std::size_t index)
+    {
+        auto it{ std::ranges::begin(r) };
+
+        it += static_cast<std::ranges::range_difference_t<R>>(index);
+
+        return it;
+    }
+}
+
+//Calls f on every element, concurrently from several threads, so f must be safe to call that way
+//Splittable ranges (see split.h) hand every thread its own piece, so e.g. v | views::enumerate sees the right
+//indices in every thread; other ranges are walked from begin() += offset
+template <std::ranges::sized_range R, typename F>
+requires detail::seekable_sized_range<R> || splittable_range<R>
+void parallel_for_each(R&& r, F f, std::size_t thread_count = detail::default_thread_count())
+{
+    detail::run_partitioned(static_cast<std::size_t>(std::ranges::size(r)), thread_count,
+        [&](std::size_t, std::size_t lo, std::size_t hi) {
+            if constexpr (splittable_range<R>)
+            {
+                for (auto&& e : subrange_at(r, lo, hi))
+                {
+                    std::invoke(f, std::forward<decltype(e)>(e));
+                }
+            }
+            else
+            {
+                auto it{ detail::seek(r, lo) };
+
+                for (auto i{ lo }; i < hi; ++i, ++it)
+                {
+                    std::invoke(f, *it);
+                }
+            }
+        });
+}
+
+//Folds proj(e) of every element into init with op, which has to be associative
+//Blocks are reduced independently and their results folded in block order, so op need not be commutative
+template <detail::seekable_sized_range R, typename T, typename Op, typename Proj = std::identity>
+T parallel_reduce(R&& r, T init, Op op, Proj proj = {}, std::size_t thread_count = detail::default_thread_count())
+{
+    auto const count{ static_cast<std::size_t>(std::ranges::size(r)) };
+
+    std::vector<std::optional<T>> partials(std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(count, 1)));
+
+    detail::run_partitioned(count, partials.size(),
+        [&](std::size_t t, std::size_t lo, std::size_t hi) {
+            if (lo == hi)
+            {
+                return;
+            }
+
+            auto it{ detail::seek(r, lo) };
+            T acc(std::invoke(proj, *it));
+
+            for (auto i{ lo + 1 }; i < hi; ++i)
+            {
+                acc = std::invoke(op, std::move(acc), std::invoke(proj, *++it));
+            }
+
+            partials[t].emplace(std::move(acc));
+        });
+
+    for (auto& partial : partials)
+    {
+        if (partial)
+        {
+            init = std::invoke(op, std::move(init), std::move(*partial));
+        }
+    }
+
+    return init;
+}
+
+namespace detail
+{
+    //Two passes over the same blocks: every block is folded on its own, the block totals are folded in order into
+    //the value each block starts from, then every block is scanned again from that value into out
+    //A single block skips the first pass
+    template <typename R, typename T, typename O, typename Op>
+    O parallel_scan(R& r, O out, std::optional<T> init, Op& op, bool exclusive, std::size_t thread_count)
+    {
+        auto const count{ static_cast<std::size_t>(std::ranges::size(r)) };
+        auto const blocks{ std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(count, 1)) };
+
+        std::vector<std::optional<T>> carries(blocks);
+
+        carries[0] = std::move(init);
+
+        if (blocks > 1)
+        {
+            std::vector<std::optional<T>> totals(blocks);
+
+            run_partitioned(count, blocks,
+                [&](std::size_t t, std::size_t lo, std::size_t hi) {
+                    if (t + 1 == blocks || lo == hi)
+                    {
+                        return;
+                    }
+
+                    auto it{ seek(r, lo) };
+                    T acc(*it);
+
+                    for (auto i{ lo + 1 }; i < hi; ++i)
+                    {
+                        acc = std::invoke(op, std::move(acc), *++it);
+                    }
+
+                    totals[t].emplace(std::move(acc));
+                });
+
+            for (std::size_t t{ 0 }; t + 1 < blocks; ++t)
+            {
+                if (carries[t] && totals[t])
+                {
+                    carries[t + 1].emplace(std::invoke(op, *carries[t], *totals[t]));
+                }
+                else
+                {
+                    carries[t + 1] = carries[t] ? carries[t] : totals[t];
+                }
+            }
+        }
+
+        run_partitioned(count, blocks,
+            [&](std::size_t t, std::size_t lo, std::size_t hi) {
+                if (lo == hi)
+                {
+                    return;
+                }
+
+                auto it{ seek(r, lo) };
+                auto o{ out + static_cast<std::iter_difference_t<O>>(lo) };
+                auto const& carry{ carries[t] };
+
+                if (exclusive)
+                {
+                    *o = *carry;
+                }
+
+                T acc(carry ? T(std::invoke(op, *carry, *it)) : T(*it));
+
+                for (auto i{ lo + 1 }; i < hi; ++i)
+                {
+                    *(exclusive ? ++o : o++) = acc;
+                    acc = std::invoke(op, std::move(acc), *++it);
+                }
+
+                if (!exclusive)
+                {
+                    *o = std::move(acc);
+                }
+            });
+
+        return out + static_cast<std::iter_difference_t<O>>(count);
+    }
+}
+
+//Writes the running fold of r under op to out and returns the end of the output, like std::inclusive_scan
+//op has to be associative; it is applied in element order inside each block and block totals are folded in order,
+//so it need not be commutative
+template <detail::seekable_sized_range R, std::random_access_iterator O, typename Op = std::plus<>>
+O parallel_inclusive_scan(R&& r, O out, Op op = {}, std::size_t thread_count = detail::default_thread_count())
+{
+    return detail::parallel_scan<R, std::ranges::range_value_t<R>>(r, out, std::nullopt, op, false, thread_count);
+}
+
+//Like parallel_inclusive_scan but element i of the output folds the elements before i into init
+template <detail::seekable_sized_range R, std::random_access_iterator O, typename T, typename Op = std::plus<>>
+O parallel_exclusive_scan(R&& r, O out, T init, Op op = {}, std::size_t thread_count = detail::default_thread_count())
+{
+    return detail::parallel_scan<R, T>(r, out, std::optional<T>{ std::move(init) }, op, true, thread_count);
+}
+
+//Index of the first element satisfying pred, or std::nullopt
+//Workers publish matches to a shared bound and stop as soon as they pass it, so a hit in an early block
+//cancels the search of every later block
+template <detail::seekable_sized_range R, typename Pred>
+std::optional<std::size_t> parallel_find_if(R&& r, Pred pred, std::size_t thread_count = detail::default_thread_count())
+{
+    auto const count{ static_cast<std::size_t>(std::ranges::size(r)) };
+    std::atomic<std::size_t> found{ count };
+
+    detail::run_partitioned(count, thread_count,
+        [&](std::size_t, std::size_t lo, std::size_t hi) {
+            auto it{ detail::seek(r, lo) };
+
+            for (auto i{ lo }; i < hi && i < found.load(std::memory_order_relaxed); ++i, ++it)
+            {
+                if (std::invoke(pred, *it))
+                {
+                    auto bound{ found.load(std::memory_order_relaxed) };
+
+                    while (i < bound && !found.compare_exchange_weak(bound, i, std::memory_order_relaxed))
+                    {
+
+                    }
+
+                    return;
+                }
+            }
+        });
+
+    if (auto const index{ found.load() }; index != count)
+    {
+        return index;
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,122 @@
+#include "enumerate.h"
+#include "parallel.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+	//Sizes that do not divide evenly among the thread counts, and fewer elements than threads
+	constexpr std::size_t sizes[]{ 0, 1, 2, 5, 7, 100, 1001 };
+	constexpr std::size_t thread_counts[]{ 1, 2, 3, 8, 64 };
+}
+
+TEST_CASE("parallel_for_each visits every element once")
+{
+	for (auto const size : sizes)
+	{
+		for (auto const threads : thread_counts)
+		{
+			std::vector<int> visits(size);
+
+			parallel_for_each(visits, [](int& e) { ++e; }, threads);
+
+			REQUIRE(std::ranges::count(visits, 1) == static_cast<std::ptrdiff_t>(size));
+		}
+	}
+}
+
+TEST_CASE("parallel_for_each hands every thread the right enumerate indices")
+{
+	for (auto const size : sizes)
+	{
+		std::vector<int> values(size);
+		std::iota(std::begin(values), std::end(values), 0);
+
+		for (auto const threads : thread_counts)
+		{
+			std::vector<std::size_t> indices(size, size);
+
+			parallel_for_each(values | views::enumerate, [&](auto const& p) { indices[p.second] = p.first; }, threads);
+
+			for (std::size_t i{ 0 }; i < size; ++i)
+			{
+				REQUIRE(indices[i] == i);
+			}
+		}
+	}
+}
+
+TEST_CASE("parallel_for_each rethrows an exception from a worker")
+{
+	std::vector<int> const v(100);
+	auto calls{ 0 };
+
+	REQUIRE_THROWS_AS(parallel_for_each(v, [&](int) { if (++calls == 1) throw std::runtime_error("first"); }, 1), std::runtime_error);
+	REQUIRE_THROWS_AS(parallel_for_each(std::views::iota(0, 100), [](int i) { if (i == 90) throw std::runtime_error("last block"); }, 4), std::runtime_error);
+}
+
+TEST_CASE("parallel_reduce folds in element order")
+{
+	for (auto const size : sizes)
+	{
+		std::vector<std::string> letters;
+
+		for (std::size_t i{ 0 }; i < size; ++i)
+		{
+			letters.emplace_back(1, static_cast<char>('a' + i % 26));
+		}
+
+		auto const expected{ std::accumulate(std::begin(letters), std::end(letters), std::string{ ">" }) };
+		long long squares{ 0 };
+
+		for (long long i{ 0 }; i < static_cast<long long>(size); ++i)
+		{
+			squares += i * i;
+		}
+
+		for (auto const threads : thread_counts)
+		{
+			REQUIRE(parallel_reduce(letters, std::string{ ">" }, std::plus<>{}, std::identity{}, threads) == expected);
+			REQUIRE(parallel_reduce(std::views::iota(0LL, static_cast<long long>(size)), 0LL, std::plus<>{},
+				[](long long i) { return i * i; }, threads) == squares);
+		}
+	}
+}
+
+TEST_CASE("parallel_find_if returns the first match")
+{
+	std::vector<int> v(1001);
+
+	for (auto const threads : thread_counts)
+	{
+		std::ranges::fill(v, 0);
+		REQUIRE(parallel_find_if(v, [](int e) { return e == 1; }, threads) == std::nullopt);
+
+		//Matches in the first block and in every later one, so a later block finishing first must not win
+		for (auto const i : { 3, 400, 401, 700, 1000 })
+		{
+			v[i] = 1;
+		}
+
+		REQUIRE(parallel_find_if(v, [](int e) { return e == 1; }, threads) == 3);
+
+		v[3] = 0;
+		REQUIRE(parallel_find_if(v, [](int e) { return e == 1; }, threads) == 400);
+
+		std::ranges::fill(v, 0);
+		v[1000] = 1;
+		REQUIRE(parallel_find_if(v, [](int e) { return e == 1; }, threads) == 1000);
+	}
+
+	std::vector<int> const empty;
+
+	REQUIRE(parallel_find_if(empty, [](int) { return true; }, 8) == std::nullopt);
+	REQUIRE(parallel_find_if(std::vector{ 5, 5 }, [](int) { return true; }, 8) == 0);
+}
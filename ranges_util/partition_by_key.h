@@ -0,0 +1,309 @@
+#pragma once
+
+#include "parallel.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Counting-sort partition of a range into domain_size contiguous buckets
+//The projection must map every element to an integral key in [0, domain_size)
+//Sized random access ranges are partitioned by several threads, so the projection may be called concurrently
+//and must be safe to call that way
+//Elements keep their relative order inside a bucket
+template <typename T>
+class partition_by_key_view
+    : public std::ranges::view_interface<partition_by_key_view<T>>
+{
+public:
+    using bucket_type = std::span<T>;
+
+    partition_by_key_view() = default;
+
+    template <std::ranges::forward_range R, typename F>
+    partition_by_key_view(R&& r, F proj, std::size_t domain_size)
+        : storage_{ std::make_shared<storage>() }
+    {
+        if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+        {
+            partition_parallel(std::forward<R>(r), proj, domain_size);
+        }
+        else
+        {
+            partition_sequential(std::forward<R>(r), proj, domain_size);
+        }
+    }
+
+    constexpr auto begin() const
+    {
+        return std::ranges::begin(buckets());
+    }
+
+    constexpr auto end() const
+    {
+        return std::ranges::end(buckets());
+    }
+
+    constexpr auto size() const
+    {
+        return std::ranges::size(buckets());
+    }
+
+    //All elements in bucket order
+    constexpr std::span<T> elements() const
+    {
+        return storage_ ? std::span<T>{ storage_->data_, storage_->count_ } : std::span<T>{};
+    }
+
+private:
+    //Single allocation holding every element, shared between copies of the view
+    struct storage
+    {
+        T* data_ = nullptr;
+        std::size_t count_ = 0;
+        bool complete_ = false;
+        std::vector<bucket_type> buckets_;
+
+        storage() = default;
+        storage(storage const&) = delete;
+        storage& operator=(storage const&) = delete;
+
+        ~storage()
+        {
+            if (data_)
+            {
+                if (complete_)
+                {
+                    std::destroy_n(data_, count_);
+                }
+
+                std::allocator<T>{}.deallocate(data_, count_);
+            }
+        }
+
+        void allocate(std::size_t count)
+        {
+            count_ = count;
+
+            if (count_ != 0)
+            {
+                data_ = std::allocator<T>{}.allocate(count_);
+            }
+        }
+
+        //Destroy the partially filled slots [starts[k], cursors[k]) after a failed scatter
+        void destroy_partial(std::size_t const* starts, std::size_t const* cursors, std::size_t domain_size)
+        {
+            for (std::size_t k{ 0 }; k < domain_size; ++k)
+            {
+                std::destroy(data_ + starts[k], data_ + cursors[k]);
+            }
+        }
+
+        //offsets holds domain_size + 1 bucket boundaries
+        void make_buckets(std::vector<std::size_t> const& offsets)
+        {
+            complete_ = true;
+            buckets_.reserve(offsets.size() - 1);
+
+            for (std::size_t i{ 0 }; i + 1 < offsets.size(); ++i)
+            {
+                buckets_.emplace_back(data_ + offsets[i], offsets[i + 1] - offsets[i]);
+            }
+        }
+    };
+
+    std::shared_ptr<storage> storage_;
+
+    //A default constructed view has no storage and no buckets
+    constexpr std::span<bucket_type const> buckets() const
+    {
+        return storage_ ? std::span<bucket_type const>{ storage_->buckets_ } : std::span<bucket_type const>{};
+    }
+
+    //Below this many elements per thread spawning threads costs more than it saves
+    static constexpr std::size_t min_elements_per_thread = 1 << 15;
+
+    template <typename F, typename E>
+    static std::size_t key_of(F& proj, E&& e, std::size_t domain_size)
+    {
+        auto const key{ std::invoke(proj, std::forward<E>(e)) };
+
+        if (std::cmp_less(key, 0) || std::cmp_greater_equal(key, domain_size))
+        {
+            throw std::out_of_range("partition_by_key: key outside of [0, domain_size)");
+        }
+
+        return static_cast<std::size_t>(key);
+    }
+
+    template <typename R, typename F>
+    void partition_sequential(R&& r, F& proj, std::size_t domain_size)
+    {
+        std::vector<std::size_t> offsets(domain_size + 1);
+        //The keys of the histogram pass, so the scatter pass does not run the projection again
+        std::vector<std::size_t> keys;
+
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            keys.reserve(static_cast<std::size_t>(std::ranges::size(r)));
+        }
+
+        //Histogram pass
+        for (auto&& e : r)
+        {
+            ++offsets[keys.emplace_back(key_of(proj, e, domain_size)) + 1];
+        }
+
+        auto const count{ keys.size() };
+
+        std::partial_sum(std::begin(offsets), std::end(offsets), std::begin(offsets));
+
+        storage_->allocate(count);
+
+        //Scatter pass
+        auto cursors{ offsets };
+
+        try
+        {
+            auto key{ std::begin(keys) };
+
+            for (auto&& e : r)
+            {
+                auto& cursor{ cursors[*key++] };
+
+                std::construct_at(storage_->data_ + cursor, e);
+                ++cursor;
+            }
+        }
+        catch (...)
+        {
+            storage_->destroy_partial(offsets.data(), cursors.data(), domain_size);
+            throw;
+        }
+
+        storage_->make_buckets(offsets);
+    }
+
+    template <typename R, typename F>
+    void partition_parallel(R&& r, F& proj, std::size_t domain_size)
+    {
+        auto const first{ std::ranges::begin(r) };
+        auto const count{ static_cast<std::size_t>(std::ranges::size(r)) };
+        auto const thread_count{ std::clamp<std::size_t>(
+            count / min_elements_per_thread, 1, detail::default_thread_count()) };
+
+        //histograms[t * domain_size + k] is the number of elements with key k in the chunk of thread t
+        std::vector<std::size_t> histograms(thread_count * domain_size);
+        //The keys of the histogram pass, so the scatter pass does not run the projection again
+        std::vector<std::size_t> keys(count);
+
+        //Histogram pass, one private histogram per thread
+        detail::run_partitioned(count, thread_count, [&](std::size_t t, std::size_t lo, std::size_t hi) {
+            auto* const histogram{ histograms.data() + t * domain_size };
+
+            auto it{ first + static_cast<std::ranges::range_difference_t<R>>(lo) };
+
+            for (auto i{ lo }; i < hi; ++i, ++it)
+            {
+                ++histogram[keys[i] = key_of(proj, *it, domain_size)];
+            }
+        });
+
+        //Turn the histograms into write cursors: bucket-major, then thread-major so the partition is stable
+        std::vector<std::size_t> offsets(domain_size + 1);
+        std::size_t total{ 0 };
+
+        for (std::size_t k{ 0 }; k < domain_size; ++k)
+        {
+            offsets[k] = total;
+
+            for (std::size_t t{ 0 }; t < thread_count; ++t)
+            {
+                total += std::exchange(histograms[t * domain_size + k], total);
+            }
+        }
+
+        offsets[domain_size] = total;
+
+        storage_->allocate(count);
+
+        //Scatter pass, every thread writes to disjoint slots
+        auto const starts{ histograms };
+
+        try
+        {
+            detail::run_partitioned(count, thread_count, [&](std::size_t t, std::size_t lo, std::size_t hi) {
+                auto* const cursors{ histograms.data() + t * domain_size };
+
+                auto it{ first + static_cast<std::ranges::range_difference_t<R>>(lo) };
+
+                for (auto i{ lo }; i < hi; ++i, ++it)
+                {
+                    auto& cursor{ cursors[keys[i]] };
+
+                    std::construct_at(storage_->data_ + cursor, *it);
+                    ++cursor;
+                }
+            });
+        }
+        catch (...)
+        {
+            for (std::size_t t{ 0 }; t < thread_count; ++t)
+            {
+                storage_->destroy_partial(starts.data() + t * domain_size, histograms.data() + t * domain_size, domain_size);
+            }
+
+            throw;
+        }
+
+        storage_->make_buckets(offsets);
+    }
+};
+
+template <std::ranges::forward_range R, typename F>
+partition_by_key_view(R&&, F, std::size_t)->partition_by_key_view<std::ranges::range_value_t<R>>;
+
+namespace views
+{
+    namespace detail
+    {
+        template <typename F>
+        struct partition_by_key_closure
+        {
+            F f;
+            std::size_t domain_size;
+
+            template <std::ranges::forward_range R>
+            friend auto operator|(R&& r, partition_by_key_closure&& c)
+            {
+                return partition_by_key_view(std::forward<R>(r), std::move(c.f), c.domain_size);
+            }
+        };
+
+        struct partition_by_key_fn
+        {
+            template <typename F>
+            constexpr auto operator()(F f, std::size_t domain_size) const
+            {
+                return partition_by_key_closure<F>{ std::move(f), domain_size };
+            }
+
+            template <std::ranges::forward_range R, typename F>
+            auto operator()(R&& r, F f, std::size_t domain_size) const
+            {
+                return partition_by_key_view(std::forward<R>(r), std::move(f), domain_size);
+            }
+        };
+    }
+
+    constexpr inline detail::partition_by_key_fn partition_by_key;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "partition_by_key.h"
+#include <algorithm>
+#include <atomic>
+#include <catch.hpp>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("partition_by_key buckets are stable")
+{
+	std::list const a{ 5, 3, 8, 1, 4, 7, 2, 6 };
+	auto const view{ a | views::partition_by_key([](int e) { return e % 3; }, 3) };
+
+	REQUIRE(view.size() == 3);
+	REQUIRE(std::ranges::equal(view[0], std::vector{ 3, 6 }));
+	REQUIRE(std::ranges::equal(view[1], std::vector{ 1, 4, 7 }));
+	REQUIRE(std::ranges::equal(view[2], std::vector{ 5, 8, 2 }));
+	REQUIRE(std::ranges::equal(view.elements(), std::vector{ 3, 6, 1, 4, 7, 5, 8, 2 }));
+}
+
+TEST_CASE("partition_by_key over a large random access range")
+{
+	std::vector<int> a(1 << 17);
+	std::iota(std::begin(a), std::end(a), 0);
+
+	auto const view{ views::partition_by_key(a, [](int e) { return e % 7; }, 7) };
+
+	std::size_t total{ 0 };
+
+	for (std::size_t k{ 0 }; k < view.size(); ++k)
+	{
+		REQUIRE(std::ranges::is_sorted(view[k]));
+		REQUIRE(std::ranges::all_of(view[k], [k](int e) { return static_cast<std::size_t>(e % 7) == k; }));
+		total += view[k].size();
+	}
+
+	REQUIRE(total == a.size());
+}
+
+TEST_CASE("partition_by_key projects every element once")
+{
+	//The large vector is projected from several threads
+	std::atomic<std::size_t> calls{ 0 };
+	auto const key{ [&](int e) { ++calls; return e % 4; } };
+
+	std::list const l{ 1, 2, 3, 4, 5, 6 };
+	static_cast<void>(views::partition_by_key(l, key, 4));
+	REQUIRE(calls == l.size());
+
+	calls = 0;
+
+	std::vector<int> v(1 << 17);
+	static_cast<void>(views::partition_by_key(v, key, 4));
+	REQUIRE(calls == v.size());
+}
+
+TEST_CASE("partition_by_key rejects keys outside the domain")
+{
+	std::vector const a{ 0, 1, 2, 3 };
+
+	REQUIRE_THROWS_AS(views::partition_by_key(a, [](int e) { return e; }, 3), std::out_of_range);
+	REQUIRE_THROWS_AS(views::partition_by_key(a, [](int e) { return e - 1; }, 4), std::out_of_range);
+}
+
+TEST_CASE("default constructed partition_by_key is empty")
+{
+	partition_by_key_view<int> const view;
+
+	REQUIRE(view.size() == 0);
+	REQUIRE(view.begin() == view.end());
+	REQUIRE(view.elements().empty());
+}
@@ -14,6 +14,22 @@
 #include "chunk_by.h"
 #include "chunk_by_key.h"
 #include "stride.h"
+#include "partition_by_key.h"
+#include "split_by.h"
+#include "cycle_cursor.h"
+#include "parallel.h"
+#include "tiled_cartesian_product.h"
+#include "sample.h"
+#include "cartesian_product_pruned.h"
+#include "gray_cartesian_product.h"
+#include "hash_join.h"
+#include "cartesian_power.h"
+#include "split.h"
+#include "strided_nd.h"
+#include "chunk.h"
+#include "slide.h"
+#include "scan.h"
+#include "instrument.h"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -23,6 +39,11 @@
 #include <deque>
 #include <forward_list>
 #include <numeric>
+#include <sstream>
+#include <thread>
+#include <array>
+#include <algorithm>
+#include <cstdint>
 
 int main()
 {
@@ -173,6 +194,451 @@ int main()
             std::cout << e << ' ';
         }
     }
+
+    // partition_by_key
+    {
+        std::vector v{ 5, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+
+        for (auto&& [key, bucket] : v | views::partition_by_key([](auto e) { return e % 3; }, 3) | views::enumerate)
+        {
+            std::cout << "\nBucket " << key << ':';
+
+            for (auto&& e : bucket)
+            {
+                std::cout << ' ' << e;
+            }
+        }
+
+        std::cout << '\n';
+    }
+
+    // chunk_by_key over sorted input
+    {
+        std::vector<int> timestamps(1000);
+
+        std::iota(std::begin(timestamps), std::end(timestamps), 0);
+
+        for (auto&& [bucket, group] : timestamps | views::chunk_by_key([](auto t) { return t / 250; }, sorted_tag))
+        {
+            std::cout << "Bucket " << bucket << ": " << std::ranges::size(group) << " samples\n";
+        }
+    }
+
+    // chunk_by_key over a single pass input range
+    {
+        std::istringstream readings{ "3 3 3 7 7 1 1 1 1" };
+
+        for (auto&& [value, run] : std::views::istream<int>(readings) | views::chunk_by_key([](auto e) { return e; }))
+        {
+            std::cout << value << " x " << std::ranges::distance(run) << '\n';
+        }
+    }
+
+    // split_by
+    {
+        std::string const csv{ "id, name,,age" };
+
+        for (std::string_view field : csv | views::split_by(", "))
+        {
+            std::cout << '[' << field << ']';
+        }
+
+        std::cout << '\n';
+    }
+
+    // Latest groups first
+    {
+        std::vector log{ 1, 1, 2, 2, 2, 3, 4, 4 };
+
+        for (auto&& group : log | views::chunk_by(std::equal_to<>{}) | std::views::reverse | std::views::take(2))
+        {
+            std::cout << group.front() << " x " << group.size() << '\n';
+        }
+    }
+
+    // cycle_n
+    {
+        std::vector<unsigned char> pattern{ 0xde, 0xad, 0xbe, 0xef };
+        auto padding{ pattern | views::cycle_n(4096) | to<std::vector>() };
+
+        std::cout << padding.size() << " bytes of padding\n";
+    }
+
+    // shared_cycle_cursor
+    {
+        std::vector<std::string> backends{ "10.0.0.1", "10.0.0.2", "10.0.0.3" };
+        shared_cycle_cursor dispatcher{ backends };
+
+        {
+            std::vector<std::jthread> workers;
+
+            for (auto i{ 0 }; i < 4; ++i)
+            {
+                workers.emplace_back([&dispatcher] {
+                    for (auto&& backend : dispatcher.claim(3))
+                    {
+                        (void)backend;
+                    }
+                });
+            }
+        }
+
+        std::cout << dispatcher.claimed() << " requests dispatched, next goes to " << dispatcher.next() << '\n';
+    }
+
+    {
+        std::cout << "Parallel search over a cartesian product" << std::endl;
+
+        std::vector<int> xs(100), ys(100), zs(100);
+
+        std::iota(std::begin(xs), std::end(xs), 0);
+        std::iota(std::begin(ys), std::end(ys), 0);
+        std::iota(std::begin(zs), std::end(zs), 0);
+
+        auto const product{ views::cartesian_product(xs, ys, zs) };
+
+        if (auto const index{ parallel_find_if(product, [](auto const& e) {
+            auto const& [x, y, z] { e };
+            return x * x + y * y == z * z && x > 10 && y > x;
+            }) })
+        {
+            auto const& [x, y, z] { *(product.begin() + static_cast<std::ptrdiff_t>(*index)) };
+
+            std::cout << x << "^2 + " << y << "^2 = " << z << "^2" << std::endl;
+        }
+
+        std::cout << parallel_reduce(product, 0LL, std::plus<>{}, [](auto const& e) {
+            return static_cast<long long>(std::get<0>(e));
+            }) << std::endl;
+    }
+
+    {
+        std::cout << "Tiled cartesian product" << std::endl;
+
+        std::vector<int> v{ 0, 1, 2, 3 };
+
+        for (auto const [x, y] : views::tiled_cartesian_product(2, v, v))
+        {
+            std::cout << "(" << x << ", " << y << ") ";
+        }
+
+        std::cout << std::endl;
+    }
+
+    {
+        std::cout << "Nested loops over a cartesian product" << std::endl;
+
+        std::vector<int> rows{ 1, 2, 3 };
+        std::vector<int> columns{ 1, 2, 3 };
+
+        cartesian_for_each([](int row, int column) {
+            std::cout << row * column << (column == 3 ? "\n" : " ");
+            }, rows, columns);
+    }
+
+    {
+        std::cout << "Random configurations out of a product space" << std::endl;
+
+        std::vector<int> threads{ 1, 2, 4, 8, 16, 32 };
+        std::vector<int> batch_sizes{ 16, 32, 64, 128, 256 };
+        std::vector<std::string> schedulers{ "fifo", "lifo", "fair" };
+
+        auto const space{ views::cartesian_product(threads, batch_sizes, schedulers) };
+
+        for (auto const& [t, b, s] : space | views::sample(4, 2022))
+        {
+            std::cout << t << " threads, batch " << b << ", " << s << std::endl;
+        }
+
+        auto const& [t, b, s] { space.unrank(42) };
+
+        std::cout << "#42: " << t << " threads, batch " << b << ", " << s
+            << " (rank " << space.rank(space.begin() + 42) << ")" << std::endl;
+    }
+
+    {
+        std::cout << "Six queens by pruned cartesian product" << std::endl;
+
+        //Accept a prefix of columns if the queen placed last attacks none of the earlier ones
+        auto const safe{ [](auto... columns) {
+            std::array<int, sizeof...(columns)> const placed{ columns... };
+            auto const last{ placed.size() - 1 };
+
+            for (std::size_t row{ 0 }; row < last; ++row)
+            {
+                auto const distance{ static_cast<int>(last - row) };
+
+                if (placed[row] == placed[last] || placed[row] - placed[last] == distance || placed[last] - placed[row] == distance)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        } };
+
+        auto const columns{ std::views::iota(0, 6) };
+
+        for (auto const& solution : views::cartesian_product_pruned(safe, columns, columns, columns, columns, columns, columns))
+        {
+            std::apply([](auto... column) { ((std::cout << column << " "), ...); }, solution);
+            std::cout << std::endl;
+        }
+    }
+
+    {
+        std::cout << "Gray code order with incremental cost" << std::endl;
+
+        std::vector<int> widths{ 1, 2, 3 };
+        std::vector<int> heights{ 10, 20 };
+        std::vector<int> depths{ 100, 200 };
+
+        auto const product{ views::gray_cartesian_product(widths, heights, depths) };
+        auto it{ product.begin() };
+        auto cost{ std::apply([](auto... e) { return (e + ...); }, *it) };
+
+        for (; it != product.end(); ++it)
+        {
+            it.visit_change([&](auto, int old_value, int new_value) { cost += new_value - old_value; });
+
+            std::cout << cost << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+    {
+        std::cout << "Joining orders to customers" << std::endl;
+
+        struct customer
+        {
+            int id;
+            std::string name;
+        };
+
+        struct order
+        {
+            int customer_id;
+            int amount;
+        };
+
+        std::vector<customer> customers{ { 1, "potato" }, { 2, "bard" }, { 3, "oatmeal" } };
+        std::vector<order> orders{ { 1, 30 }, { 3, 12 }, { 1, 7 }, { 4, 99 } };
+
+        for (auto const& [c, o] : views::hash_join(customers, orders, &customer::id, &order::customer_id))
+        {
+            std::cout << c.name << ": " << o.amount << std::endl;
+        }
+
+        std::ranges::sort(orders, {}, &order::customer_id);
+
+        for (auto const& [c, o] : views::sort_merge_join(customers, orders, &customer::id, &order::customer_id))
+        {
+            std::cout << c.name << ": " << o.amount << std::endl;
+        }
+    }
+
+    {
+        std::cout << "k-mers by cartesian power" << std::endl;
+
+        std::string const bases{ "ACGT" };
+
+        for (auto const& [first, second] : views::cartesian_power<2>(bases))
+        {
+            std::cout << first << second << " ";
+        }
+
+        std::cout << std::endl;
+
+        std::size_t palindromes{ 0 };
+
+        for (auto const kmer : views::cartesian_power(bases, 5))
+        {
+            palindromes += std::ranges::equal(kmer, kmer | std::views::reverse) ? 1 : 0;
+        }
+
+        std::cout << palindromes << " of " << views::cartesian_power(bases, 5).size() << " 5-mers read the same backwards" << std::endl;
+    }
+
+    {
+        std::cout << "Enumerate on all cores" << std::endl;
+
+        std::vector<int> values(20);
+        std::vector<std::size_t> indices(values.size());
+
+        parallel_for_each(values | views::enumerate, [&](auto const& p) {
+            auto const& [index, value] { p };
+
+            indices[index] = index;
+            }, 4);
+
+        auto const every_third{ std::views::iota(0, 10) | views::stride(3) };
+
+        for (auto const& piece : split(every_third, 2))
+        {
+            for (auto e : piece)
+            {
+                std::cout << e << " ";
+            }
+
+            std::cout << "| ";
+        }
+
+        std::cout << std::endl << (std::ranges::equal(indices, std::views::iota(std::size_t{ 0 }, indices.size())) ? "indices match" : "indices differ") << std::endl;
+    }
+
+
+    {
+        std::cout << "Fused enumerate loop" << std::endl;
+
+        std::vector<int> v{ 5, 6, 7, 8 };
+        long long weighted{ 0 };
+
+        enumerate_for_each(v, [&](std::size_t index, int e) { weighted += static_cast<long long>(index) * e; });
+        (v | views::enumerate).for_each([](std::size_t index, int e) { std::cout << index << ":" << e << " "; });
+
+        std::cout << std::endl << weighted << std::endl;
+    }
+
+
+    {
+        std::cout << "Compact enumerate indices" << std::endl;
+
+        std::vector<int> v{ 5, 6, 7, 8 };
+        auto const wide{ to<std::vector>(v | views::enumerate) };
+        auto const narrow{ to<std::vector>(v | views::enumerate_as<std::uint32_t>) };
+
+        std::cout << sizeof(wide[0]) << " vs " << sizeof(narrow[0]) << " bytes per element" << std::endl;
+
+        for (auto&& [index, e] : views::enumerate(v, std::uint32_t{ 100 }))
+        {
+            std::cout << index << ":" << e << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    {
+        std::cout << "Gather one channel of interleaved samples" << std::endl;
+
+        std::vector<float> interleaved(12);
+        std::iota(std::begin(interleaved), std::end(interleaved), 0.0f);
+
+        for (auto e : to<std::vector<float>>(interleaved | std::views::drop(1) | views::stride(3)))
+        {
+            std::cout << e << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    {
+        std::cout << "Matrix rows, columns and tiles" << std::endl;
+
+        std::vector<int> pixels(4 * 6);
+        std::iota(std::begin(pixels), std::end(pixels), 0);
+
+        auto const image{ views::strided_nd(pixels, { 4, 6 }) };
+
+        for (auto e : image.column(1))
+        {
+            std::cout << e << " ";
+        }
+
+        std::cout << "| ";
+
+        for (auto const& tile : image.tiles({ 2, 3 }))
+        {
+            std::cout << std::accumulate(std::begin(tile), std::end(tile), 0) << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    {
+        std::cout << "Chunks, windows and window aggregates" << std::endl;
+
+        std::vector<int> telemetry{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+
+        for (auto const& chunk : telemetry | views::chunk(4))
+        {
+            std::cout << std::accumulate(std::begin(chunk), std::end(chunk), 0) << " ";
+        }
+
+        std::cout << "| ";
+
+        for (auto const& window : telemetry | views::slide(3))
+        {
+            std::cout << std::ranges::max(window) << " ";
+        }
+
+        std::cout << "| ";
+
+        for (auto e : telemetry | views::sliding_max(3))
+        {
+            std::cout << e << " ";
+        }
+
+        std::cout << "| ";
+
+        for (auto e : telemetry | views::sliding_sum(3))
+        {
+            std::cout << e << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    {
+        std::cout << "Group offsets and running totals" << std::endl;
+
+        std::vector<int> log{ 1, 1, 2, 2, 2, 3, 4, 4 };
+        auto const group_sizes{ log | views::chunk_by(std::equal_to<>{}) | std::views::transform([](auto&& group) { return std::ranges::distance(group); }) };
+
+        for (auto offset : group_sizes | views::exclusive_scan(std::ptrdiff_t{ 0 }))
+        {
+            std::cout << offset << " ";
+        }
+
+        std::vector<long long> totals(log.size());
+
+        parallel_inclusive_scan(log, std::begin(totals), std::plus<>{}, 3);
+
+        std::cout << "| ";
+
+        for (auto e : totals)
+        {
+            std::cout << e << " ";
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    {
+        std::cout << "Instrumented pipeline" << std::endl;
+
+        std::vector<int> readings{ 1, 1, 2, 3, 3, 3, 4, 5, 5, 6, 6, 6 };
+
+        instruments().reset();
+
+        for (auto&& [index, group] : readings
+            | views::instrument("readings")
+            | views::chunk_by(instrumented_predicate("same reading", std::equal_to<>{}))
+            | views::instrument("groups")
+            | views::enumerate)
+        {
+            std::cout << index << ":" << std::ranges::distance(group) << " ";
+        }
+
+        std::cout << std::endl;
+
+        instruments().report(std::cout);
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+//k distinct elements drawn uniformly at random, in the order they appear in the base
+//Positions are chosen with Floyd's algorithm and every element is reached with a single iterator jump,
+//so the cost is proportional to k and not to the size of the base, e.g. a huge cartesian_product_view
+//If the base has fewer than k elements all of them are taken
+template <std::ranges::view V>
+requires detail::seekable_sized_range<V const>
+class sample_view
+    : public std::ranges::view_interface<sample_view<V>>
+{
+    V base_;
+    //Sorted positions, shared between copies of the view
+    std::shared_ptr<std::vector<std::size_t> const> positions_;
+
+    class iterator
+    {
+        using base_iterator = std::ranges::iterator_t<V const>;
+        using position_iterator = std::vector<std::size_t>::const_iterator;
+
+        base_iterator begin_{};
+        position_iterator current_{};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::ranges::range_reference_t<V const>;
+        using value_type = std::ranges::range_value_t<V const>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr iterator(base_iterator begin, position_iterator current)
+            : begin_{ std::move(begin) }, current_{ std::move(current) }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            auto it{ begin_ };
+
+            it += static_cast<std::ranges::range_difference_t<V const>>(*current_);
+
+            return *it;
+        }
+
+        //Position of the current element in the base
+        constexpr std::size_t position() const
+        {
+            return *current_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++current_;
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++current_;
+
+            return temp;
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.current_ == y.current_;
+        }
+    };
+
+    static std::vector<std::size_t> choose(std::size_t n, std::size_t k, std::uint64_t seed)
+    {
+        std::vector<std::size_t> positions;
+
+        if (k >= n)
+        {
+            positions.resize(n);
+            std::iota(std::begin(positions), std::end(positions), std::size_t{ 0 });
+
+            return positions;
+        }
+
+        //Floyd: for j in [n - k, n) pick t in [0, j]; take j instead if t was already taken
+        std::mt19937_64 engine{ seed };
+        std::unordered_set<std::size_t> chosen;
+
+        chosen.reserve(k);
+        positions.reserve(k);
+
+        for (auto j{ n - k }; j < n; ++j)
+        {
+            auto const t{ std::uniform_int_distribution<std::size_t>{ 0, j }(engine) };
+
+            auto const position{ chosen.insert(t).second ? t : j };
+
+            chosen.insert(position);
+            positions.push_back(position);
+        }
+
+        std::ranges::sort(positions);
+
+        return positions;
+    }
+
+public:
+    sample_view() = default;
+
+    sample_view(V base, std::size_t k, std::uint64_t seed)
+        : base_{ std::move(base) },
+        positions_{ std::make_shared<std::vector<std::size_t> const>(choose(static_cast<std::size_t>(std::ranges::size(std::as_const(base_))), k, seed)) }
+    {
+
+    }
+
+    constexpr auto begin() const
+    {
+        return iterator{ std::ranges::begin(base_), std::ranges::cbegin(*positions_) };
+    }
+
+    constexpr auto end() const
+    {
+        return iterator{ std::ranges::begin(base_), std::ranges::cend(*positions_) };
+    }
+
+    constexpr std::size_t size() const
+    {
+        return std::ranges::size(*positions_);
+    }
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+};
+
+template <typename R>
+sample_view(R&&, std::size_t, std::uint64_t)->sample_view<std::views::all_t<R>>;
+
+namespace views
+{
+    namespace detail
+    {
+        struct sample_closure
+        {
+            std::size_t k;
+            std::uint64_t seed;
+
+            template <std::ranges::viewable_range R>
+            requires ::detail::seekable_sized_range<std::views::all_t<R> const>
+            friend auto operator|(R&& r, sample_closure const& c)
+            {
+                return sample_view(std::forward<R>(r), c.k, c.seed);
+            }
+        };
+
+        struct sample_fn
+        {
+            constexpr auto operator()(std::size_t k, std::uint64_t seed = std::random_device{}()) const
+            {
+                return sample_closure{ k, seed };
+            }
+
+            template <std::ranges::viewable_range R>
+            requires ::detail::seekable_sized_range<std::views::all_t<R> const>
+            auto operator()(R&& r, std::size_t k, std::uint64_t seed = std::random_device{}()) const
+            {
+                return sample_view(std::forward<R>(r), k, seed);
+            }
+        };
+    }
+
+    constexpr inline detail::sample_fn sample;
+}
@@ -0,0 +1,48 @@
+#include "cartesian_product.h"
+#include "sample.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+TEST_CASE("sample yields k distinct positions in base order")
+{
+	std::vector const a{ 1, 2, 3 };
+	std::string const b{ "xy" };
+	std::vector const c{ 0.5, 1.5, 2.5, 3.5 };
+	auto const product{ views::cartesian_product(a, b, c) };
+	auto const size{ product.size() };
+
+	for (std::size_t k : { std::size_t{ 0 }, std::size_t{ 1 }, size - 1, size })
+	{
+		for (std::uint64_t seed{ 0 }; seed < 20; ++seed)
+		{
+			auto const view{ product | views::sample(k, seed) };
+			std::size_t count{ 0 };
+			std::ptrdiff_t previous{ -1 };
+
+			REQUIRE(view.size() == k);
+
+			for (auto it{ view.begin() }; it != view.end(); ++it, ++count)
+			{
+				//Strictly increasing, so the positions are distinct and in the order of the base
+				REQUIRE(static_cast<std::ptrdiff_t>(it.position()) > previous);
+				REQUIRE(it.position() < size);
+				REQUIRE(*it == product.unrank(it.position()));
+				previous = static_cast<std::ptrdiff_t>(it.position());
+			}
+
+			REQUIRE(count == k);
+		}
+	}
+}
+
+TEST_CASE("sample of more elements than the base has takes all of them")
+{
+	std::vector const v{ 4, 5, 6 };
+	auto const view{ views::sample(v, 10, 1) };
+
+	REQUIRE(std::ranges::equal(view, v));
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "common.h"
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+//Running fold of a range, one element out per element in, like std::inclusive_scan / std::exclusive_scan
+//e.g. { 1, 2, 3 } | views::inclusive_scan() is { 1, 3, 6 } and { 1, 2, 3 } | views::exclusive_scan(10) is { 10, 11, 13 }
+//The iterator carries the running value and reads every base element once, so input ranges such as the groups
+//of chunk_by_key can be scanned in a single pass; parallel_inclusive_scan (parallel.h) materializes large
+//random access ranges on several threads
+template <std::ranges::input_range V, typename T, typename Op, bool Exclusive>
+requires std::ranges::view<V>
+class scan_view
+    : public std::ranges::view_interface<scan_view<V, T, Op, Exclusive>>
+{
+    V base_;
+    //The first element of an inclusive scan without an initial value is the first element of the base
+    std::optional<T> init_;
+    Op op_;
+
+    template <bool Const>
+    class iterator
+    {
+        using Base = std::conditional_t<Const, V const, V>;
+        using Parent = std::conditional_t<Const, scan_view const, scan_view>;
+
+        std::ranges::iterator_t<Base> current_{};
+        std::ranges::sentinel_t<Base> end_{};
+        Parent* parent_ = nullptr;
+        std::optional<T> value_;
+
+        constexpr void fold()
+        {
+            value_ = value_ ? T(std::invoke(parent_->op_, std::move(*value_), *current_)) : T(*current_);
+        }
+
+    public:
+        using iterator_category = std::conditional_t<std::ranges::forward_range<Base>, std::forward_iterator_tag, std::input_iterator_tag>;
+        using value_type = T;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+
+        constexpr explicit iterator(Parent* parent)
+            : current_{ std::ranges::begin(parent->base_) }, end_{ std::ranges::end(parent->base_) }, parent_{ parent }, value_{ parent->init_ }
+        {
+            if (!Exclusive && current_ != end_)
+            {
+                fold();
+            }
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
+            : current_{ std::move(i.current_) }, end_{ std::move(i.end_) }, parent_{ i.parent_ }, value_{ std::move(i.value_) }
+        {
+
+        }
+
+        constexpr std::ranges::iterator_t<Base> base() const
+        {
+            return current_;
+        }
+
+        constexpr T operator*() const
+        {
+            return *value_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            if constexpr (Exclusive)
+            {
+                fold();
+                ++current_;
+            }
+            else if (++current_ != end_)
+            {
+                fold();
+            }
+
+            return *this;
+        }
+
+        constexpr void operator++(int) requires (!std::ranges::forward_range<Base>)
+        {
+            ++*this;
+        }
+
+        constexpr iterator operator++(int) requires std::ranges::forward_range<Base>
+        {
+            auto temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y) requires std::equality_comparable<std::ranges::iterator_t<Base>>
+        {
+            return x.current_ == y.current_;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.current_ == x.end_;
+        }
+
+        friend constexpr difference_type operator-(std::default_sentinel_t, iterator const& x) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return x.end_ - x.current_;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, std::default_sentinel_t y) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return -(y - x);
+        }
+
+        friend class iterator<!Const>;
+    };
+
+public:
+    scan_view() = default;
+
+    constexpr scan_view(V base, std::optional<T> init, Op op)
+        : base_{ std::move(base) }, init_{ std::move(init) }, op_{ std::move(op) }
+    {
+
+    }
+
+    constexpr auto begin()
+    {
+        return iterator<false>(this);
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::input_range<V const> && std::regular_invocable<Op const&, T, std::ranges::range_reference_t<V const>>
+    {
+        return iterator<true>(this);
+    }
+
+    //The running value lives in the iterator, so the end is a sentinel
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<V const>
+    {
+        return std::ranges::size(base_);
+    }
+
+    constexpr V base() const& requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+};
+
+namespace views
+{
+    namespace detail
+    {
+        template <typename T, typename Op, bool Exclusive>
+        struct scan_view_closure
+        {
+            std::optional<T> init_;
+            Op op_;
+
+            template <std::ranges::viewable_range R>
+            friend constexpr auto operator|(R&& r, scan_view_closure const& clos)
+            {
+                return scan_view<std::views::all_t<R>, T, Op, Exclusive>{ std::views::all(std::forward<R>(r)), clos.init_, clos.op_ };
+            }
+        };
+
+        //Without an initial value the running value has the element type of the base
+        template <typename Op>
+        struct inclusive_scan_closure
+        {
+            Op op_;
+
+            template <std::ranges::viewable_range R>
+            friend constexpr auto operator|(R&& r, inclusive_scan_closure const& clos)
+            {
+                using value_type = std::ranges::range_value_t<R>;
+
+                return scan_view<std::views::all_t<R>, value_type, Op, false>{ std::views::all(std::forward<R>(r)), std::nullopt, clos.op_ };
+            }
+        };
+
+        class inclusive_scan_fn
+        {
+        public:
+            template <std::ranges::viewable_range R, typename Op = std::plus<>>
+            constexpr auto operator()(R&& r, Op op = {}) const
+            {
+                return std::forward<R>(r) | inclusive_scan_closure<Op>{ std::move(op) };
+            }
+
+            template <typename Op = std::plus<>>
+            requires (!std::ranges::range<Op>)
+            constexpr auto operator()(Op op = {}) const
+            {
+                return inclusive_scan_closure<Op>{ std::move(op) };
+            }
+
+            //Folds the first element into init instead of starting from it, like std::inclusive_scan(..., op, init)
+            template <typename Op, typename T>
+            requires (!std::ranges::range<Op>)
+            constexpr auto operator()(Op op, T init) const
+            {
+                return scan_view_closure<T, Op, false>{ std::move(init), std::move(op) };
+            }
+        };
+
+        class exclusive_scan_fn
+        {
+        public:
+            template <std::ranges::viewable_range R, typename T, typename Op = std::plus<>>
+            constexpr auto operator()(R&& r, T init, Op op = {}) const
+            {
+                return std::forward<R>(r) | scan_view_closure<T, Op, true>{ std::move(init), std::move(op) };
+            }
+
+            template <typename T, typename Op = std::plus<>>
+            requires (!std::ranges::range<T>)
+            constexpr auto operator()(T init, Op op = {}) const
+            {
+                return scan_view_closure<T, Op, true>{ std::move(init), std::move(op) };
+            }
+        };
+    }
+
+    inline constexpr detail::inclusive_scan_fn inclusive_scan;
+    inline constexpr detail::exclusive_scan_fn exclusive_scan;
+}
@@ -0,0 +1,103 @@
+#include "parallel.h"
+#include "scan.h"
+#include <catch.hpp>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::vector<std::string> letters(std::size_t count)
+	{
+		std::vector<std::string> out;
+
+		for (std::size_t i{ 0 }; i < count; ++i)
+		{
+			out.emplace_back(1, static_cast<char>('a' + i % 26));
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("parallel scans match the standard scans")
+{
+	for (std::size_t count : { 0, 1, 2, 7, 100, 1001 })
+	{
+		std::vector<long long> v(count);
+		std::iota(std::begin(v), std::end(v), 1);
+
+		std::vector<long long> expected(count);
+		std::vector<long long> out(count);
+
+		for (std::size_t threads : { 1, 2, 3, 8 })
+		{
+			std::inclusive_scan(std::begin(v), std::end(v), std::begin(expected));
+			REQUIRE(parallel_inclusive_scan(v, std::begin(out), std::plus<>{}, threads) == std::end(out));
+			REQUIRE(out == expected);
+
+			std::exclusive_scan(std::begin(v), std::end(v), std::begin(expected), 10LL);
+			REQUIRE(parallel_exclusive_scan(v, std::begin(out), 10LL, std::plus<>{}, threads) == std::end(out));
+			REQUIRE(out == expected);
+		}
+	}
+}
+
+TEST_CASE("parallel scans keep the order of a non-commutative op")
+{
+	for (std::size_t count : { 0, 1, 5, 64 })
+	{
+		auto const v{ letters(count) };
+		std::vector<std::string> expected(count);
+		std::vector<std::string> out(count);
+
+		for (std::size_t threads : { 1, 2, 3, 8 })
+		{
+			std::inclusive_scan(std::begin(v), std::end(v), std::begin(expected), std::plus<>{});
+			parallel_inclusive_scan(v, std::begin(out), std::plus<>{}, threads);
+			REQUIRE(out == expected);
+
+			std::exclusive_scan(std::begin(v), std::end(v), std::begin(expected), std::string{ ">" }, std::plus<>{});
+			parallel_exclusive_scan(v, std::begin(out), std::string{ ">" }, std::plus<>{}, threads);
+			REQUIRE(out == expected);
+		}
+	}
+}
+
+TEST_CASE("scan views match the standard scans")
+{
+	auto const v{ letters(30) };
+	std::vector<std::string> expected(v.size());
+
+	std::inclusive_scan(std::begin(v), std::end(v), std::begin(expected), std::plus<>{});
+	REQUIRE(std::ranges::equal(v | views::inclusive_scan(), expected));
+
+	std::inclusive_scan(std::begin(v), std::end(v), std::begin(expected), std::plus<>{}, std::string{ ">" });
+	REQUIRE(std::ranges::equal(v | views::inclusive_scan(std::plus<>{}, std::string{ ">" }), expected));
+
+	std::exclusive_scan(std::begin(v), std::end(v), std::begin(expected), std::string{ ">" }, std::plus<>{});
+	REQUIRE(std::ranges::equal(views::exclusive_scan(v, std::string{ ">" }), expected));
+
+	std::vector<int> const empty;
+
+	REQUIRE(std::ranges::empty(empty | views::inclusive_scan()));
+	REQUIRE(std::ranges::equal(std::vector{ 4 } | views::inclusive_scan(), std::vector{ 4 }));
+	REQUIRE(std::ranges::equal(std::vector{ 4 } | views::exclusive_scan(1), std::vector{ 1 }));
+}
+
+TEST_CASE("inclusive_scan over an input range reads it in one pass")
+{
+	std::istringstream in{ "1 2 3 4 5" };
+	std::vector<int> out;
+
+	for (auto const sum : std::views::istream<int>(in) | views::inclusive_scan())
+	{
+		out.push_back(sum);
+	}
+
+	REQUIRE(out == std::vector{ 1, 3, 6, 10, 15 });
+}
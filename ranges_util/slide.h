@@ -0,0 +1,578 @@
+#pragma once
+
+#include "common.h"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Overlapping windows of n consecutive elements, one per position where a whole window fits
+//e.g. { 1, 2, 3, 4 } | views::slide(2) is { 1, 2 } { 2, 3 } { 3, 4 }
+//The iterator keeps both ends of its window, so stepping is O(1) for any forward base
+//n has to be positive; slide_view throws std::out_of_range otherwise
+template <std::ranges::forward_range V>
+requires std::ranges::view<V>
+class slide_view
+    : public std::ranges::view_interface<slide_view<V>>
+{
+public:
+    slide_view() = default;
+    slide_view(V base, std::ranges::range_difference_t<V> n)
+        : base_(std::move(base)), n_(n)
+    {
+        if (n_ <= 0)
+        {
+            throw std::out_of_range("slide_view: window size must be positive");
+        }
+    }
+
+    constexpr auto begin() requires (!simple_view<V>)
+    {
+        return iterator<false>(std::ranges::begin(base_), n_, std::addressof(base_));
+    }
+
+    constexpr auto begin() const requires std::ranges::forward_range<const V>
+    {
+        return iterator<true>(std::ranges::begin(base_), n_, std::addressof(base_));
+    }
+
+    constexpr auto end() requires (!simple_view<V>)
+    {
+        return end_of<false>(base_);
+    }
+
+    constexpr auto end() const requires std::ranges::forward_range<const V>
+    {
+        return end_of<true>(base_);
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V>
+    {
+        return window_count(std::ranges::size(base_));
+    }
+
+    constexpr auto size() const requires std::ranges::sized_range<const V>
+    {
+        return window_count(std::ranges::size(base_));
+    }
+
+    constexpr V base() const& requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+
+private:
+    V base_;
+    std::ranges::range_difference_t<V> n_ = 1;
+
+    template <typename S>
+    constexpr S window_count(S size) const
+    {
+        auto const n{ static_cast<S>(n_) };
+
+        return size < n ? 0 : size - n + 1;
+    }
+
+    template <bool Const>
+    class iterator
+    {
+        using Base = std::conditional_t<Const, const V, V>;
+
+        //First and last element of the window; last_ is the base's end once there is no whole window left
+        std::ranges::iterator_t<Base> current_{};
+        std::ranges::iterator_t<Base> last_{};
+        std::ranges::sentinel_t<Base> end_{};
+
+    public:
+        using iterator_category = std::conditional_t<
+            std::ranges::random_access_range<Base>, std::random_access_iterator_tag, std::conditional_t<
+            std::ranges::bidirectional_range<Base>, std::bidirectional_iterator_tag, std::forward_iterator_tag>>;
+        using reference = std::ranges::subrange<std::ranges::iterator_t<Base>>;
+        using value_type = reference;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() = default;
+        constexpr explicit iterator(std::ranges::iterator_t<Base> current, difference_type n, Base* base)
+            : current_{ current }, last_{ current }, end_{ std::ranges::end(*base) }
+        {
+            std::ranges::advance(last_, n - 1, end_);
+        }
+
+        constexpr explicit iterator(std::ranges::iterator_t<Base> current, std::ranges::iterator_t<Base> last, Base* base)
+            : current_{ std::move(current) }, last_{ std::move(last) }, end_{ std::ranges::end(*base) }
+        {
+
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
+            : current_{ std::move(i.current_) }, last_{ std::move(i.last_) }, end_{ std::move(i.end_) }
+        {
+
+        }
+
+        constexpr std::ranges::iterator_t<Base> base() const
+        {
+            return current_;
+        }
+
+        constexpr value_type operator*() const
+        {
+            return { current_, std::ranges::next(last_) };
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++current_;
+            ++last_;
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator--() requires std::ranges::bidirectional_range<Base>
+        {
+            --current_;
+            --last_;
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int) requires std::ranges::bidirectional_range<Base>
+        {
+            auto temp{ *this };
+
+            --*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type x) requires std::ranges::random_access_range<Base>
+        {
+            current_ += x;
+            last_ += x;
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type x) requires std::ranges::random_access_range<Base>
+        {
+            return *this += -x;
+        }
+
+        constexpr value_type operator[](difference_type n) const requires std::ranges::random_access_range<Base>
+        {
+            return *(*this + n);
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.last_ == y.last_;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.last_ == x.end_;
+        }
+
+        friend constexpr auto operator<=>(iterator const& x, iterator const& y) requires std::ranges::random_access_range<Base> && std::three_way_comparable<std::ranges::iterator_t<Base>>
+        {
+            return x.last_ <=> y.last_;
+        }
+
+        friend constexpr iterator operator+(iterator x, difference_type y) requires std::ranges::random_access_range<Base>
+        {
+            return x += y;
+        }
+
+        friend constexpr iterator operator+(difference_type x, iterator y) requires std::ranges::random_access_range<Base>
+        {
+            return y += x;
+        }
+
+        friend constexpr iterator operator-(iterator x, difference_type y) requires std::ranges::random_access_range<Base>
+        {
+            return x -= y;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y) requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return x.last_ - y.last_;
+        }
+
+        friend constexpr difference_type operator-(std::default_sentinel_t, iterator const& x) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return x.end_ - x.last_;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, std::default_sentinel_t y) requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            return -(y - x);
+        }
+
+        friend class iterator<!Const>;
+    };
+
+    //With random access the end iterator is computed directly; otherwise finding it would walk the base
+    template <bool Const, typename Base>
+    constexpr auto end_of(Base& base) const
+    {
+        if constexpr (std::ranges::random_access_range<Base> && std::ranges::sized_range<Base> && std::ranges::common_range<Base>)
+        {
+            auto const count{ static_cast<std::ranges::range_difference_t<Base>>(window_count(std::ranges::size(base))) };
+
+            return iterator<Const>(std::ranges::begin(base) + count, std::ranges::end(base), std::addressof(base));
+        }
+        else
+        {
+            return std::default_sentinel;
+        }
+    }
+};
+
+template <class R>
+slide_view(R&&, std::ranges::range_difference_t<R>)->slide_view<std::views::all_t<R>>;
+
+//Window reducers for sliding_reduce_view: push adds the element entering the window, pop removes the one
+//leaving it (given with its position in the stream), value is the aggregate of the current window
+namespace detail
+{
+    //Integer sums are exact, so the element leaving the window can just be subtracted
+    //The sum is kept in the widest integer of the same signedness, so a window of large values does not overflow
+    template <std::integral T>
+    class window_sum
+    {
+        using sum_type = std::conditional_t<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>;
+
+        sum_type sum_{};
+
+    public:
+        constexpr void push(std::size_t, T const& value)
+        {
+            sum_ += static_cast<sum_type>(value);
+        }
+
+        constexpr void pop(std::size_t, T const& value)
+        {
+            sum_ -= static_cast<sum_type>(value);
+        }
+
+        constexpr sum_type value() const
+        {
+            return sum_;
+        }
+    };
+
+    //Two-stack aggregate for any associative op, which never undoes an element the way subtracting does
+    //Adding then subtracting a floating point value does not give back the sum it started from, e.g.
+    //{ 1e16, 1, 1, 1 } would sum to 1e16 1 1 over windows of 2; here it is 1e16 2 2
+    //Newer elements are pushed on back_ with their running fold; when front_ runs out, back_ is moved over as
+    //suffix folds of the older elements, so each element is folded a constant number of times, O(1) amortized
+    template <typename T, typename Op>
+    class window_fold
+    {
+        //front_.back() is the fold of every older element still in the window
+        std::vector<T> front_;
+        std::vector<T> back_;
+        T back_fold_{};
+        Op op_;
+
+    public:
+        window_fold() = default;
+        constexpr explicit window_fold(Op op)
+            : op_{ std::move(op) }
+        {
+
+        }
+
+        constexpr void push(std::size_t, T const& value)
+        {
+            back_fold_ = back_.empty() ? value : std::invoke(op_, back_fold_, value);
+            back_.push_back(value);
+        }
+
+        constexpr void pop(std::size_t, T const&)
+        {
+            if (front_.empty())
+            {
+                for (auto i{ back_.size() }; i-- > 0;)
+                {
+                    front_.push_back(front_.empty() ? back_[i] : std::invoke(op_, back_[i], front_.back()));
+                }
+
+                back_.clear();
+            }
+
+            front_.pop_back();
+        }
+
+        constexpr T value() const
+        {
+            if (back_.empty())
+            {
+                return front_.back();
+            }
+
+            return front_.empty() ? back_fold_ : std::invoke(op_, front_.back(), back_fold_);
+        }
+    };
+
+    //Monotonic deque: an element that is not better than a newer one can never be the answer again, so it is
+    //dropped on push; each element is pushed and popped at most once, O(1) amortized per step
+    template <typename T, typename Comp>
+    class window_extremum
+    {
+        std::deque<std::pair<std::size_t, T>> candidates_;
+        Comp comp_;
+
+    public:
+        window_extremum() = default;
+        constexpr explicit window_extremum(Comp comp)
+            : comp_{ std::move(comp) }
+        {
+
+        }
+
+        void push(std::size_t position, T const& value)
+        {
+            while (!candidates_.empty() && !std::invoke(comp_, candidates_.back().second, value))
+            {
+                candidates_.pop_back();
+            }
+
+            candidates_.emplace_back(position, value);
+        }
+
+        void pop(std::size_t position, T const&)
+        {
+            if (candidates_.front().first == position)
+            {
+                candidates_.pop_front();
+            }
+        }
+
+        T value() const
+        {
+            return candidates_.front().second;
+        }
+    };
+}
+
+//Aggregate of every window of slide(n), updated in O(1) per step instead of reducing each window again
+//The iterator owns the reducer state, so this is an input range; n has to be positive as for slide_view
+template <std::ranges::forward_range V, typename Reducer>
+requires std::ranges::view<V>
+class sliding_reduce_view
+    : public std::ranges::view_interface<sliding_reduce_view<V, Reducer>>
+{
+    V base_;
+    std::ranges::range_difference_t<V> n_ = 1;
+    Reducer reducer_;
+
+    class iterator
+    {
+        //tail_ is the oldest element of the window, head_ the next one to enter
+        std::ranges::iterator_t<V> tail_{};
+        std::ranges::iterator_t<V> head_{};
+        std::ranges::sentinel_t<V> end_{};
+        //Position of tail_ in the base
+        std::size_t position_ = 0;
+        std::size_t n_ = 0;
+        Reducer reducer_;
+        bool done_ = false;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = decltype(std::declval<Reducer const&>().value());
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        constexpr iterator(V& base, std::ranges::range_difference_t<V> n, Reducer reducer)
+            : tail_{ std::ranges::begin(base) }, head_{ tail_ }, end_{ std::ranges::end(base) }, n_{ static_cast<std::size_t>(n) }, reducer_{ std::move(reducer) }
+        {
+            for (std::ranges::range_difference_t<V> i{ 0 }; i < n; ++i, ++head_)
+            {
+                if (head_ == end_)
+                {
+                    done_ = true;
+
+                    return;
+                }
+
+                reducer_.push(static_cast<std::size_t>(i), *head_);
+            }
+        }
+
+        constexpr value_type operator*() const
+        {
+            return reducer_.value();
+        }
+
+        constexpr iterator& operator++()
+        {
+            if (head_ == end_)
+            {
+                done_ = true;
+
+                return *this;
+            }
+
+            reducer_.pop(position_, *tail_);
+            reducer_.push(position_ + n_, *head_);
+            ++tail_;
+            ++head_;
+            ++position_;
+
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t)
+        {
+            return x.done_;
+        }
+    };
+
+public:
+    sliding_reduce_view() = default;
+    constexpr sliding_reduce_view(V base, std::ranges::range_difference_t<V> n, Reducer reducer)
+        : base_{ std::move(base) }, n_{ n }, reducer_{ std::move(reducer) }
+    {
+        if (n_ <= 0)
+        {
+            throw std::out_of_range("sliding_reduce_view: window size must be positive");
+        }
+    }
+
+    constexpr auto begin()
+    {
+        return iterator{ base_, n_, reducer_ };
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+
+    constexpr auto size() requires std::ranges::sized_range<V>
+    {
+        auto const size{ std::ranges::size(base_) };
+        auto const n{ static_cast<decltype(size)>(n_) };
+
+        return size < n ? 0 : size - n + 1;
+    }
+};
+
+namespace views
+{
+    namespace detail
+    {
+        template <std::integral D>
+        struct slide_view_closure
+        {
+            D n_;
+
+            template <std::ranges::viewable_range V>
+            friend constexpr auto operator|(V&& v, slide_view_closure const& clos)
+            {
+                return slide_view{ std::forward<V>(v), clos.n_ };
+            }
+        };
+
+        class slide_fn
+        {
+        public:
+            template <std::ranges::viewable_range V>
+            constexpr auto operator()(V&& v, std::ranges::range_difference_t<V> n) const
+            {
+                return slide_view{ std::forward<V>(v), n };
+            }
+
+            template <std::integral D>
+            constexpr auto operator()(D n) const
+            {
+                return slide_view_closure{ n };
+            }
+        };
+
+        //make(value_type) builds the reducer for a base with that element type
+        template <typename Make>
+        struct sliding_reduce_closure
+        {
+            std::ptrdiff_t n_;
+            Make make_;
+
+            template <std::ranges::viewable_range V>
+            friend constexpr auto operator|(V&& v, sliding_reduce_closure const& clos)
+            {
+                using base_type = std::views::all_t<V>;
+                using reducer_type = decltype(clos.make_(std::type_identity<std::ranges::range_value_t<base_type>>{}));
+
+                return sliding_reduce_view<base_type, reducer_type>{ std::views::all(std::forward<V>(v)),
+                    static_cast<std::ranges::range_difference_t<base_type>>(clos.n_), clos.make_(std::type_identity<std::ranges::range_value_t<base_type>>{}) };
+            }
+        };
+
+        template <typename Make>
+        sliding_reduce_closure(std::ptrdiff_t, Make)->sliding_reduce_closure<Make>;
+
+        class sliding_sum_fn
+        {
+        public:
+            constexpr auto operator()(std::ptrdiff_t n) const
+            {
+                return sliding_reduce_closure{ n, []<typename T>(std::type_identity<T>) {
+                    if constexpr (std::integral<T>)
+                    {
+                        return ::detail::window_sum<T>{};
+                    }
+                    else
+                    {
+                        return ::detail::window_fold<T, std::plus<T>>{};
+                    }
+                    } };
+            }
+        };
+
+        template <typename DefaultComp>
+        class sliding_extremum_fn
+        {
+        public:
+            template <typename Comp = DefaultComp>
+            constexpr auto operator()(std::ptrdiff_t n, Comp comp = {}) const
+            {
+                return sliding_reduce_closure{ n, [comp]<typename T>(std::type_identity<T>) { return ::detail::window_extremum<T, Comp>{ comp }; } };
+            }
+        };
+    }
+
+    inline constexpr detail::slide_fn slide;
+
+    //Sum, minimum and maximum of every window of n elements, e.g. samples | views::sliding_max(60)
+    inline constexpr detail::sliding_sum_fn sliding_sum;
+    inline constexpr detail::sliding_extremum_fn<std::ranges::less> sliding_min;
+    inline constexpr detail::sliding_extremum_fn<std::ranges::greater> sliding_max;
+}
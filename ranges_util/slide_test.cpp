@@ -0,0 +1,113 @@
+#include "slide.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <climits>
+#include <cstdint>
+#include <forward_list>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+	template <typename R>
+	auto collect(R&& r)
+	{
+		std::vector<std::ranges::range_value_t<R>> out;
+
+		for (auto e : r)
+		{
+			out.push_back(e);
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("slide yields every window that fits")
+{
+	std::vector const v{ 1, 2, 3, 4 };
+	std::forward_list const f(std::begin(v), std::end(v));
+	std::vector<std::vector<int>> windows;
+
+	for (auto const& window : f | views::slide(2))
+	{
+		windows.emplace_back(std::ranges::begin(window), std::ranges::end(window));
+	}
+
+	REQUIRE(windows == std::vector<std::vector<int>>{ { 1, 2 }, { 2, 3 }, { 3, 4 } });
+	REQUIRE((v | views::slide(2)).size() == 3);
+	REQUIRE((v | views::slide(4)).size() == 1);
+	REQUIRE((v | views::slide(5)).size() == 0);
+	REQUIRE(std::ranges::empty(v | views::slide(5)));
+
+	auto const slides{ v | views::slide(3) };
+
+	REQUIRE(std::ranges::equal(*(slides.end() - 1), std::vector{ 2, 3, 4 }));
+}
+
+TEST_CASE("sliding_sum of integers does not overflow the element type")
+{
+	std::vector const v{ INT_MAX, INT_MAX, INT_MAX, 1 };
+	auto const sums{ collect(v | views::sliding_sum(2)) };
+
+	STATIC_REQUIRE(std::is_same_v<std::ranges::range_value_t<decltype(v | views::sliding_sum(2))>, std::intmax_t>);
+	REQUIRE(sums == std::vector<std::intmax_t>{ 2LL * INT_MAX, 2LL * INT_MAX, INT_MAX + 1LL });
+}
+
+TEST_CASE("sliding_sum of floating point does not drift")
+{
+	std::vector const v{ 1e16, 1.0, 1.0, 1.0 };
+
+	REQUIRE(collect(v | views::sliding_sum(2)) == std::vector{ 1e16, 2.0, 2.0 });
+
+	//A running sum would lose the ones added next to each 1e16 and stay low once it has left the window
+	std::vector<double> w(1000);
+
+	for (std::size_t i{ 0 }; i < std::size(w); ++i)
+	{
+		w[i] = i % 10 == 0 ? 1e16 : 1.0;
+	}
+
+	auto const sums{ collect(w | views::sliding_sum(4)) };
+
+	for (std::size_t i{ 0 }; i < std::size(sums); ++i)
+	{
+		if (std::none_of(std::begin(w) + i, std::begin(w) + i + 4, [](double e) { return e > 1.0; }))
+		{
+			REQUIRE(sums[i] == 4.0);
+		}
+	}
+}
+
+TEST_CASE("sliding_min and sliding_max match reducing every window")
+{
+	std::vector const v{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+
+	for (std::ptrdiff_t n{ 1 }; n <= std::ssize(v) + 1; ++n)
+	{
+		std::vector<int> mins, maxes;
+
+		for (auto const& window : v | views::slide(n))
+		{
+			mins.push_back(std::ranges::min(window));
+			maxes.push_back(std::ranges::max(window));
+		}
+
+		REQUIRE(collect(v | views::sliding_min(n)) == mins);
+		REQUIRE(collect(v | views::sliding_max(n)) == maxes);
+	}
+}
+
+TEST_CASE("slide and the sliding reducers reject a window that is not positive")
+{
+	std::vector const v{ 1, 2, 3 };
+
+	REQUIRE_THROWS_AS(v | views::slide(0), std::out_of_range);
+	REQUIRE_THROWS_AS(v | views::slide(-1), std::out_of_range);
+	REQUIRE_THROWS_AS(v | views::sliding_sum(0), std::out_of_range);
+	REQUIRE_THROWS_AS(v | views::sliding_max(0), std::out_of_range);
+	REQUIRE_THROWS_AS(std::vector{ 1.0 } | views::sliding_sum(-3), std::out_of_range);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+//Splittable range protocol: cut a range into independent pieces that threads can walk on their own
+//subrange_at(r, first, last) is the elements [first, last) of r as a range of its own, in O(1)
+//Views whose elements depend on their position (enumerate's index, stride's phase, cycle's phase) provide
+//a member r.subrange_at(first, last) that carries that state into the piece; any other sized random access range
+//is cut with std::ranges::subrange
+namespace detail
+{
+    template <typename R>
+    concept has_subrange_at = requires(R& r, std::size_t i) { r.subrange_at(i, i); };
+}
+
+template <std::ranges::range R>
+requires detail::has_subrange_at<R> || (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+constexpr auto subrange_at(R& r, std::size_t first, std::size_t last)
+{
+    if constexpr (detail::has_subrange_at<R>)
+    {
+        return r.subrange_at(first, last);
+    }
+    else
+    {
+        auto const begin{ std::ranges::begin(r) };
+
+        return std::ranges::subrange(begin + static_cast<std::ranges::range_difference_t<R>>(first),
+            begin + static_cast<std::ranges::range_difference_t<R>>(last));
+    }
+}
+
+template <typename R>
+concept splittable_range = std::ranges::sized_range<R> && requires(R& r, std::size_t i) { subrange_at(r, i, i); };
+
+//n pieces of (almost) equal size covering the whole range in order
+//There are fewer pieces than n if the range has fewer than n elements
+template <splittable_range R>
+auto split(R& r, std::size_t n)
+{
+    auto const count{ static_cast<std::size_t>(std::ranges::size(r)) };
+
+    n = std::clamp<std::size_t>(n, 1, std::max<std::size_t>(count, 1));
+
+    auto const block{ (count + n - 1) / n };
+    std::vector<decltype(subrange_at(r, 0, 0))> pieces;
+
+    pieces.reserve(n);
+
+    for (std::size_t first{ 0 }; first < count || pieces.empty(); first += block)
+    {
+        pieces.push_back(subrange_at(r, first, std::min(first + block, count)));
+    }
+
+    return pieces;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common.h"
+#include "chunk_by.h"
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+//Tokenizer yielding std::basic_string_view tokens that point into the original characters
+//Runs of delimiters are skipped, so no empty tokens are produced
+//e.g. std::string_view{ "a, b,,c" } | views::split_by(", ") yields "a", "b", "c"
+namespace views
+{
+    namespace detail
+    {
+        template <typename CharT>
+        struct single_delimiter
+        {
+            CharT delimiter;
+
+            constexpr bool operator()(CharT c) const
+            {
+                return c == delimiter;
+            }
+        };
+
+        template <typename CharT>
+        struct any_delimiter
+        {
+            std::basic_string_view<CharT> delimiters;
+
+            constexpr bool operator()(CharT c) const
+            {
+                return delimiters.find(c) != std::basic_string_view<CharT>::npos;
+            }
+        };
+
+        //Neighbouring characters belong to the same chunk if both or neither are delimiters
+        template <typename P>
+        struct same_token_class
+        {
+            P is_delimiter;
+
+            template <typename CharT>
+            constexpr bool operator()(CharT lhs, CharT rhs) const
+            {
+                return is_delimiter(lhs) == is_delimiter(rhs);
+            }
+        };
+
+        template <typename P>
+        struct is_token
+        {
+            P is_delimiter;
+
+            template <typename CharT>
+            constexpr bool operator()(std::basic_string_view<CharT> chunk) const
+            {
+                return !is_delimiter(chunk.front());
+            }
+        };
+
+        template <typename P>
+        struct split_by_closure
+        {
+            P is_delimiter;
+
+            template <std::ranges::contiguous_range R>
+            requires ::detail::character<std::ranges::range_value_t<R>>
+            friend constexpr auto operator|(R&& r, split_by_closure const& c)
+            {
+                return chunk_by_view(std::forward<R>(r), same_token_class<P>{ c.is_delimiter })
+                    | std::views::filter(is_token<P>{ c.is_delimiter });
+            }
+        };
+
+        struct split_by_fn
+        {
+            template <::detail::character CharT>
+            constexpr auto operator()(CharT delimiter) const
+            {
+                return split_by_closure<single_delimiter<CharT>>{ { delimiter } };
+            }
+
+            //The delimiter characters must outlive the returned view
+            template <::detail::character CharT>
+            constexpr auto operator()(CharT const* delimiters) const
+            {
+                return split_by_closure<any_delimiter<CharT>>{ { delimiters } };
+            }
+
+            template <::detail::character CharT>
+            constexpr auto operator()(std::basic_string_view<CharT> delimiters) const
+            {
+                return split_by_closure<any_delimiter<CharT>>{ { delimiters } };
+            }
+
+            template <typename P>
+            requires (!::detail::character<P> && !std::is_pointer_v<P> && std::is_invocable_r_v<bool, P const&, char>)
+            constexpr auto operator()(P is_delimiter) const
+            {
+                return split_by_closure<P>{ std::move(is_delimiter) };
+            }
+        };
+    }
+
+    constexpr inline detail::split_by_fn split_by;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "cycle.h"
+#include "enumerate.h"
+#include "split.h"
+#include "stride.h"
+#include <catch.hpp>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	//Every split of r, from one piece to more pieces than elements, read back in order
+	template <typename R, typename F>
+	void require_splits_concatenate(R& r, F read)
+	{
+		std::vector<decltype(read(*std::ranges::begin(r)))> whole;
+
+		for (auto&& e : r)
+		{
+			whole.push_back(read(e));
+		}
+
+		for (std::size_t n{ 1 }; n <= whole.size() + 1; ++n)
+		{
+			auto const pieces{ split(r, n) };
+			decltype(whole) joined;
+
+			REQUIRE(!pieces.empty());
+			REQUIRE(pieces.size() <= n);
+
+			for (auto piece : pieces)
+			{
+				for (auto&& e : piece)
+				{
+					joined.push_back(read(e));
+				}
+			}
+
+			REQUIRE(joined == whole);
+		}
+	}
+
+	std::vector<int> iota(int count)
+	{
+		std::vector<int> out(count);
+		std::iota(std::begin(out), std::end(out), 0);
+
+		return out;
+	}
+
+	auto const copy{ [](int e) { return e; } };
+}
+
+TEST_CASE("split pieces concatenate to the range")
+{
+	for (int count : { 0, 1, 2, 7, 64 })
+	{
+		auto v{ iota(count) };
+
+		require_splits_concatenate(v, copy);
+	}
+}
+
+TEST_CASE("split keeps enumerate's indices across pieces")
+{
+	for (int count : { 0, 1, 7, 30 })
+	{
+		auto const v{ iota(count) };
+		auto view{ v | views::enumerate };
+		auto from_five{ views::enumerate(v, 5) };
+		auto const read{ [](auto const& p) { return std::pair{ static_cast<std::size_t>(p.first), p.second }; } };
+
+		require_splits_concatenate(view, read);
+		require_splits_concatenate(from_five, read);
+	}
+}
+
+TEST_CASE("split keeps stride's phase across pieces")
+{
+	for (int count : { 0, 1, 2, 7, 30, 31 })
+	{
+		auto const v{ iota(count) };
+
+		for (int stride : { 1, 2, 3, 8 })
+		{
+			auto view{ v | views::stride(stride) };
+
+			require_splits_concatenate(view, copy);
+		}
+	}
+}
+
+TEST_CASE("split keeps cycle_n's phase across pieces")
+{
+	std::vector const pattern{ 1, 2, 3 };
+
+	for (std::ptrdiff_t count : { 0, 1, 3, 10, 31 })
+	{
+		auto view{ pattern | views::cycle_n(count) };
+
+		require_splits_concatenate(view, copy);
+	}
+}
+
+TEST_CASE("cycle's subrange_at starts in the right phase")
+{
+	std::vector const pattern{ 1, 2, 3 };
+	auto const view{ pattern | views::cycle };
+
+	for (std::size_t first : { 0, 1, 2, 3, 4, 10 })
+	{
+		std::vector<int> piece;
+
+		for (auto const e : view.subrange_at(first, first + 5))
+		{
+			piece.push_back(e);
+		}
+
+		std::vector<int> expected;
+
+		for (std::size_t i{ first }; i < first + 5; ++i)
+		{
+			expected.push_back(pattern[i % pattern.size()]);
+		}
+
+		REQUIRE(piece == expected);
+	}
+}
@@ -1,10 +1,18 @@
 #pragma once
 
 #include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <ranges>
 #include <type_traits>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace detail 
 {
     //Stride view can be common if the underlying range is not bidirectional, 
@@ -13,6 +21,66 @@ namespace detail
     //the offset.
     template <typename V>
     concept stride_view_is_common = std::ranges::common_range<V> && (!std::ranges::bidirectional_range<V> || std::ranges::sized_range<V>);
+
+    //Elements that are further apart than a cache line each cost a miss, so fetch them this many elements ahead
+    constexpr std::size_t stride_prefetch_distance = 16;
+    constexpr std::ptrdiff_t cache_line_size = 64;
+
+    //out[i] = in[i * stride] for i in [0, n)
+    //4- and 8-byte elements are gathered 8 or 4 at a time with AVX2 when the build targets it; the scalar loop
+    //prefetches ahead when every element sits on a different cache line
+    template <typename T>
+    void strided_gather(T const* in, std::ptrdiff_t stride, std::size_t n, T* out)
+    {
+        std::size_t i{ 0 };
+
+#if defined(__AVX2__)
+        //The gather offsets are 32-bit, so the span of one batch has to fit
+        if (stride > 0 && stride <= std::numeric_limits<std::int32_t>::max() / 8)
+        {
+            auto const step{ static_cast<std::int32_t>(stride) };
+
+            if constexpr (sizeof(T) == 4)
+            {
+                auto const offsets{ _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(step)) };
+
+                for (; i + 8 <= n; i += 8)
+                {
+                    auto const batch{ _mm256_i32gather_epi32(reinterpret_cast<int const*>(in + i * stride), offsets, 4) };
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), batch);
+                }
+            }
+            else if constexpr (sizeof(T) == 8)
+            {
+                auto const offsets{ _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(step)) };
+
+                for (; i + 4 <= n; i += 4)
+                {
+                    auto const batch{ _mm256_i32gather_epi64(reinterpret_cast<long long const*>(in + i * stride), offsets, 8) };
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), batch);
+                }
+            }
+        }
+#endif
+
+        if (stride * static_cast<std::ptrdiff_t>(sizeof(T)) >= cache_line_size)
+        {
+            for (; i + stride_prefetch_distance < n; ++i)
+            {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+                _mm_prefetch(reinterpret_cast<char const*>(in + (i + stride_prefetch_distance) * stride), _MM_HINT_T0);
+#endif
+                out[i] = in[i * stride];
+            }
+        }
+
+        for (; i < n; ++i)
+        {
+            out[i] = in[i * stride];
+        }
+    }
 }
 
 template <std::ranges::input_range V>
@@ -49,12 +117,12 @@ public:
 
     constexpr auto end() requires (!simple_view<V> && !detail::stride_view_is_common<V>) 
     {
-        return sentinel<false>(std::ranges::end(base_), stride_, std::addressof(base_));
+        return sentinel<false>(std::ranges::end(base_));
     }
 
     constexpr auto end() const requires (std::ranges::range<const V> && !detail::stride_view_is_common<const V>) 
     {
-        return sentinel<true>(std::ranges::end(base_), stride_, std::addressof(base_));
+        return sentinel<true>(std::ranges::end(base_));
     }
 
     constexpr auto size() requires (std::ranges::sized_range<V>)
@@ -67,6 +135,42 @@ public:
         return (std::ranges::size(base_) + stride_ - 1) / stride_;
     }
 
+    //Elements [first, last) as a stride_view of their own
+    //Every piece starts on an element of the stride, so it keeps the same phase as the whole view
+    constexpr auto subrange_at(std::size_t first, std::size_t last) const
+        requires std::ranges::random_access_range<const V> && std::ranges::sized_range<const V>
+    {
+        using difference_type = std::ranges::range_difference_t<const V>;
+
+        auto const begin{ std::ranges::begin(base_) };
+        auto const size{ static_cast<difference_type>(std::ranges::size(base_)) };
+        std::ranges::subrange piece{
+            begin + std::min(static_cast<difference_type>(first) * stride_, size),
+            begin + std::min(static_cast<difference_type>(last) * stride_, size) };
+
+        return stride_view<decltype(piece)>{ std::move(piece), stride_ };
+    }
+
+    //Append all size() elements to c, picked up by to<> (see detail::bulk_appendable)
+    //Contiguous arithmetic bases are gathered a block at a time into a buffer on the stack
+    template <typename C>
+    requires std::ranges::sized_range<const V> && requires (C& c, std::ranges::range_value_t<V> const* p) { c.insert(std::end(c), p, p); }
+    void append_to(C& c) const
+    {
+        using value_type = std::ranges::range_value_t<V>;
+
+        if constexpr (std::ranges::contiguous_range<const V> && std::is_arithmetic_v<value_type>)
+        {
+            detail::append_staged<value_type>(c, static_cast<std::size_t>(size()), [&](value_type* out, std::size_t first, std::size_t n) {
+                detail::strided_gather(std::ranges::data(base_) + first * static_cast<std::size_t>(stride_), static_cast<std::ptrdiff_t>(stride_), n, out);
+            });
+        }
+        else
+        {
+            std::ranges::copy(*this, std::back_inserter(c));
+        }
+    }
+
     constexpr V base() const& requires std::copy_constructible<V>
     {
         return base_;
@@ -85,6 +189,7 @@ private:
     class sentinel;
 
     //Case when underlying range is not bidirectional, i.e. we don't care about calculating offsets
+    //Every case caches the end of the base so stepping does not call std::ranges::end
     template <
         bool Const,
         typename Base = std::conditional_t<Const, std::add_const_t<V>, V>,
@@ -94,12 +199,13 @@ private:
     struct iterator_base 
     {
         std::ranges::iterator_t<Base> current_{};
+        std::ranges::sentinel_t<Base> end_{};
         std::ranges::range_difference_t<Base> stride_;
         Base* base_;
 
         iterator_base() = default;
         constexpr explicit iterator_base(std::ranges::iterator_t<Base> current, std::ranges::range_difference_t<Base> stride, Base* base)
-            : current_{ std::move(current) }, stride_{ stride }, base_{ base }  
+            : current_{ std::move(current) }, end_{ std::ranges::end(*base) }, stride_{ stride }, base_{ base }  
         {
         
         }
@@ -120,12 +226,13 @@ private:
     struct iterator_base<Const, Base, true, false> 
     {
         std::ranges::iterator_t<Base> current_{};
+        std::ranges::sentinel_t<Base> end_{};
         std::ranges::range_difference_t<Base> stride_;
         Base* base_;
 
         iterator_base() = default;
         constexpr explicit iterator_base(std::ranges::iterator_t<Base> current, std::ranges::range_difference_t<Base> stride, Base* base)
-            : current_{ std::move(current) }, stride_{ stride }, base_{ base } 
+            : current_{ std::move(current) }, end_{ std::ranges::end(*base) }, stride_{ stride }, base_{ base } 
         {
 
         }
@@ -144,17 +251,21 @@ private:
         }
     };
 
-    //Case where underlying is bidirectional and sized. We can calculate offsets from the end on-demand.
+    //Case where underlying is bidirectional and sized. The offset of the end is the same for every iterator,
+    //so it is worked out once from the size instead of on every step back from the end
     template <bool Const, class Base>
     struct iterator_base<Const, Base, true, true>
     {
         std::ranges::iterator_t<Base> current_{};
+        std::ranges::sentinel_t<Base> end_{};
         std::ranges::range_difference_t<Base> stride_;
         Base* base_;
+        std::ranges::range_difference_t<Base> offset_ = 0;
 
         iterator_base() = default;
         constexpr explicit iterator_base(std::ranges::iterator_t<Base> current, std::ranges::range_difference_t<Base> stride, Base* base)
-            : current_{ std::move(current) }, stride_{ stride }, base_{ base }  
+            : current_{ std::move(current) }, end_{ std::ranges::end(*base) }, stride_{ stride }, base_{ base },
+            offset_{ (stride - static_cast<std::ranges::range_difference_t<Base>>(std::ranges::size(*base)) % stride) % stride }
         {
 
         }
@@ -166,7 +277,7 @@ private:
 
         std::ranges::range_difference_t<Base> get_offset() 
         {
-            return stride_ - (std::ranges::size(*base_) % stride_);
+            return offset_;
         }
     };
 
@@ -176,7 +287,7 @@ private:
         using Base = std::conditional_t<Const, const V, V>;
 
     public:
-        using iterator_category = typename std::iterator_traits<std::ranges::iterator_t<Base>>::iterator_category;
+        using iterator_category = common_iterator_category<Base>;
         using reference = std::ranges::range_reference_t<Base>;
         using value_type = std::ranges::range_value_t<Base>;
         using difference_type = std::ranges::range_difference_t<Base>;
@@ -189,7 +300,7 @@ private:
         }
 
         constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base>>
-            : iterator_base<!Const>{ std::move(i.current_), i.stride_, i.base_ } 
+            : iterator_base<Const>{ std::move(i.current_), i.stride_, i.base_ } 
         {
 
         }
@@ -211,8 +322,7 @@ private:
 
         constexpr iterator& operator++()
         {
-            auto last{ std::ranges::end(*this->base_) };
-            auto delta{ std::ranges::advance(this->current_, this->stride_, last) };
+            auto delta{ std::ranges::advance(this->current_, this->stride_, this->end_) };
 
             this->set_offset(delta);
 
@@ -237,7 +347,7 @@ private:
         {
             auto delta{ -this->stride_ };
 
-            if (this->current_ == std::ranges::end(*this->base_)) 
+            if (this->current_ == this->end_) 
             {
                 delta += this->get_offset();
             }
@@ -261,24 +371,22 @@ private:
             if (x == 0)
                 return *this;
 
-            auto last{ std::ranges::end(*this->base_) };
-
             x *= this->stride_;
 
             if (x > 0) 
             {
-                auto delta{ std::advance(this->current_, x, last) };
+                auto delta{ std::ranges::advance(this->current_, x, this->end_) };
 
                 this->set_offset(delta);
             }
             else if (x < 0) 
             {
-                if (this->current_ == last)
+                if (this->current_ == this->end_)
                 {
                     x += this->get_offset();
                 }
 
-                std::advance(this->current, x);
+                std::ranges::advance(this->current_, x);
             }
 
             return *this;
@@ -338,7 +446,15 @@ private:
 
         friend constexpr iterator operator-(iterator const& x, difference_type y) requires std::ranges::random_access_range<Base> 
         {
-            return iterator{ x } - y;
+            return iterator{ x } -= y;
+        }
+
+        //Both iterators sit on elements of the stride unless one of them is the end, so round partial steps up
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y) requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>>
+        {
+            auto const distance{ x.current_ - y.current_ };
+
+            return distance < 0 ? -((-distance + x.stride_ - 1) / x.stride_) : (distance + x.stride_ - 1) / x.stride_;
         }
 
         friend class iterator<!Const>;
@@ -360,12 +476,21 @@ private:
         
         }
 
-        friend constexpr bool operator==(sentinel const& s, std::ranges::iterator_t<parent> const& it) 
+        //A member, so it can reach the base iterator the friend iterator keeps; the base iterator may not be copyable
+        constexpr bool equal(iterator<Const> const& it) const
+        {
+            return it.current_ == end_;
+        }
+
+        friend constexpr bool operator==(iterator<Const> const& it, sentinel const& s)
         {
-            return it.current_ == s.end_;
+            return s.equal(it);
         }
 
-        constexpr sentinel(sentinel<!Const> other) requires Const && (std::convertible_to<std::ranges::sentinel_t<parent>, std::ranges::sentinel_t<parent const>>)
+        //A template, so a base that is only a range while mutable never instantiates sentinel<true>
+        template <bool OtherConst>
+        requires Const && (!OtherConst) && std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<parent>>
+        constexpr sentinel(sentinel<OtherConst> other)
             : end_(std::move(other.end_)) 
         {
 
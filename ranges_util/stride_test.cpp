@@ -0,0 +1,84 @@
+#include "stride.h"
+#include "to.h"
+#include <catch.hpp>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+namespace
+{
+	std::vector<int> every(int size, int stride)
+	{
+		std::vector<int> out;
+
+		for (int i{ 0 }; i < size; i += stride)
+		{
+			out.push_back(i);
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("stride walks back from the end whether or not the size divides")
+{
+	for (int size{ 0 }; size < 13; ++size)
+	{
+		for (int stride{ 1 }; stride < 5; ++stride)
+		{
+			std::vector<int> v(size);
+			std::iota(v.begin(), v.end(), 0);
+			std::list<int> const l(v.begin(), v.end());
+			auto const expected{ every(size, stride) | std::views::reverse };
+
+			REQUIRE(std::ranges::equal(v | views::stride(stride) | std::views::reverse, expected));
+			REQUIRE(std::ranges::equal(l | views::stride(stride) | std::views::reverse, expected));
+		}
+	}
+}
+
+TEST_CASE("stride end arithmetic on a random access base")
+{
+	std::vector const v{ 0, 1, 2, 3, 4, 5 };
+	auto const view{ v | views::stride(3) };
+
+	REQUIRE(view.end() - view.begin() == 2);
+	REQUIRE(*(view.end() - 1) == 3);
+	REQUIRE(view.end() - 2 == view.begin());
+}
+
+TEMPLATE_TEST_CASE("to<> gathers a strided contiguous range like a scalar loop", "", int, float, double, std::int64_t, char)
+{
+	//Elements per staging block of append_staged, where a gather is cut in two
+	constexpr int block{ static_cast<int>(detail::staging_block_bytes / sizeof(TestType)) };
+
+	for (int stride : { 1, 2, 3, 8, 64 })
+	{
+		//Counts around the 8 and 4 lanes of the AVX2 gathers, the prefetch distance and the staging block
+		for (int count : { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, block - 1, block, block + 1, 2 * block + 5 })
+		{
+			//The base ends anywhere from right on the last element to just before the next one
+			for (int tail : { 1, stride })
+			{
+				auto const size{ count == 0 ? 0 : (count - 1) * stride + tail };
+				std::vector<TestType> v(static_cast<std::size_t>(size));
+
+				for (int i{ 0 }; i < size; ++i)
+				{
+					v[i] = static_cast<TestType>(i % 101);
+				}
+
+				std::vector<TestType> expected;
+
+				for (int i{ 0 }; i < size; i += stride)
+				{
+					expected.push_back(v[i]);
+				}
+
+				REQUIRE(to<std::vector<TestType>>(v | views::stride(stride)) == expected);
+			}
+		}
+	}
+}
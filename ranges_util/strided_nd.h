@@ -0,0 +1,499 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//N-dimensional strided view over a random access range, laid out like std::mdspan with std::layout_stride:
+//element (i0, ..., iN-1) is base[offset + i0 * stride0 + ... + iN-1 * strideN-1]
+//Iteration is row-major over the extents; the iterator keeps its multi-index and the offset it maps to,
+//so stepping is one addition (plus a carry at the end of a row) and jumping unranks the linear position
+//Rows, columns and tiles are strided_nd_views of the same base, so slicing never copies
+template <std::ranges::view V, std::size_t N>
+requires std::ranges::random_access_range<V> && std::ranges::sized_range<V> && (N > 0)
+class strided_nd_view
+    : public std::ranges::view_interface<strided_nd_view<V, N>>
+{
+public:
+    using extents_type = std::array<std::size_t, N>;
+    using strides_type = std::array<std::ptrdiff_t, N>;
+
+    //Strides of a dense row-major array with the given extents
+    static constexpr strides_type row_major(extents_type const& extents)
+    {
+        strides_type strides{};
+        std::ptrdiff_t stride{ 1 };
+
+        for (auto d{ N }; d-- > 0;)
+        {
+            strides[d] = stride;
+            stride *= static_cast<std::ptrdiff_t>(extents[d]);
+        }
+
+        return strides;
+    }
+
+private:
+    V base_;
+    extents_type extents_{};
+    strides_type strides_{};
+    std::ptrdiff_t offset_ = 0;
+
+    template <bool Const>
+    class iterator
+    {
+        template<typename T>
+        using constify = std::conditional_t<Const, const T, T>;
+
+        constify<strided_nd_view>* parent_ = nullptr;
+        //Row-major position, the end is { extent0, 0, ..., 0 }
+        extents_type indices_{};
+        //Index into the base of the current element
+        std::ptrdiff_t offset_ = 0;
+
+        constexpr std::ptrdiff_t rank() const
+        {
+            std::ptrdiff_t index{ 0 };
+
+            for (std::size_t d{ 0 }; d < N; ++d)
+            {
+                index = index * static_cast<std::ptrdiff_t>(parent_->extents_[d]) + static_cast<std::ptrdiff_t>(indices_[d]);
+            }
+
+            return index;
+        }
+
+        constexpr void unrank(std::ptrdiff_t index)
+        {
+            offset_ = parent_->offset_;
+
+            for (auto d{ N }; d-- > 1;)
+            {
+                auto const extent{ static_cast<std::ptrdiff_t>(parent_->extents_[d]) };
+
+                indices_[d] = static_cast<std::size_t>(index % extent);
+                offset_ += static_cast<std::ptrdiff_t>(indices_[d]) * parent_->strides_[d];
+                index /= extent;
+            }
+
+            indices_[0] = static_cast<std::size_t>(index);
+            offset_ += index * parent_->strides_[0];
+        }
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using reference = std::ranges::range_reference_t<constify<V>>;
+        using value_type = std::ranges::range_value_t<constify<V>>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr explicit iterator(begin_tag_t, constify<strided_nd_view>* parent)
+            : parent_{ parent }, offset_{ parent->offset_ }
+        {
+            if (parent_->empty_extents())
+            {
+                indices_[0] = parent_->extents_[0];
+            }
+        }
+
+        constexpr explicit iterator(end_tag_t, constify<strided_nd_view>* parent)
+            : parent_{ parent }, offset_{ parent->offset_ + static_cast<std::ptrdiff_t>(parent->extents_[0]) * parent->strides_[0] }
+        {
+            indices_[0] = parent_->extents_[0];
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<V const>>
+            : parent_{ i.parent_ }, indices_{ i.indices_ }, offset_{ i.offset_ }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return std::ranges::begin(parent_->base_)[offset_];
+        }
+
+        //Multi-index of the current element
+        constexpr extents_type const& indices() const
+        {
+            return indices_;
+        }
+
+        constexpr iterator& operator++()
+        {
+            for (auto d{ N }; d-- > 1;)
+            {
+                offset_ += parent_->strides_[d];
+
+                if (++indices_[d] != parent_->extents_[d])
+                {
+                    return *this;
+                }
+
+                offset_ -= static_cast<std::ptrdiff_t>(indices_[d]) * parent_->strides_[d];
+                indices_[d] = 0;
+            }
+
+            ++indices_[0];
+            offset_ += parent_->strides_[0];
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator--()
+        {
+            for (auto d{ N }; d-- > 1;)
+            {
+                if (indices_[d] != 0)
+                {
+                    --indices_[d];
+                    offset_ -= parent_->strides_[d];
+
+                    return *this;
+                }
+
+                indices_[d] = parent_->extents_[d] - 1;
+                offset_ += static_cast<std::ptrdiff_t>(indices_[d]) * parent_->strides_[d];
+            }
+
+            --indices_[0];
+            offset_ -= parent_->strides_[0];
+
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+        {
+            auto const temp{ *this };
+
+            --*this;
+
+            return temp;
+        }
+
+        constexpr iterator& operator+=(difference_type n)
+        {
+            if (n != 0)
+            {
+                unrank(rank() + n);
+            }
+
+            return *this;
+        }
+
+        constexpr iterator& operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        constexpr decltype(auto) operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        friend constexpr iterator operator+(iterator x, difference_type n)
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator+(difference_type n, iterator x)
+        {
+            return x += n;
+        }
+
+        friend constexpr iterator operator-(iterator x, difference_type n)
+        {
+            return x -= n;
+        }
+
+        friend constexpr difference_type operator-(iterator const& x, iterator const& y)
+        {
+            return x.rank() - y.rank();
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+        {
+            return x.indices_ == y.indices_;
+        }
+
+        friend constexpr auto operator<=>(iterator const& x, iterator const& y)
+        {
+            return x.indices_ <=> y.indices_;
+        }
+
+        friend class iterator<!Const>;
+    };
+
+    constexpr std::ptrdiff_t offset_of(extents_type const& indices) const
+    {
+        auto offset{ offset_ };
+
+        for (std::size_t d{ 0 }; d < N; ++d)
+        {
+            offset += static_cast<std::ptrdiff_t>(indices[d]) * strides_[d];
+        }
+
+        return offset;
+    }
+
+    constexpr bool empty_extents() const
+    {
+        return std::ranges::find(extents_, std::size_t{ 0 }) != std::ranges::end(extents_);
+    }
+
+    //Every element the layout can reach has to lie inside the base; a layout with no elements reaches nothing
+    constexpr void check_bounds()
+    {
+        if (empty_extents())
+        {
+            return;
+        }
+
+        auto lowest{ offset_ };
+        auto highest{ offset_ };
+
+        for (std::size_t d{ 0 }; d < N; ++d)
+        {
+            auto const span{ static_cast<std::ptrdiff_t>(extents_[d] - 1) * strides_[d] };
+
+            (span < 0 ? lowest : highest) += span;
+        }
+
+        if (lowest < 0 || highest >= static_cast<std::ptrdiff_t>(std::ranges::size(base_)))
+        {
+            throw std::out_of_range("strided_nd_view: the layout reaches outside of the base");
+        }
+    }
+
+public:
+    strided_nd_view() = default;
+
+    constexpr strided_nd_view(V base, extents_type const& extents, strides_type const& strides, std::ptrdiff_t offset = 0)
+        : base_{ std::move(base) }, extents_{ extents }, strides_{ strides }, offset_{ offset }
+    {
+        check_bounds();
+    }
+
+    //Dense row-major layout
+    constexpr strided_nd_view(V base, extents_type const& extents)
+        : strided_nd_view{ std::move(base), extents, row_major(extents) }
+    {
+
+    }
+
+    constexpr auto begin()
+        requires (!simple_view<V>)
+    {
+        return iterator<false>(begin_tag, this);
+    }
+
+    constexpr auto begin() const
+        requires std::ranges::random_access_range<V const>
+    {
+        return iterator<true>(begin_tag, this);
+    }
+
+    constexpr auto end()
+        requires (!simple_view<V>)
+    {
+        return iterator<false>(end_tag, this);
+    }
+
+    constexpr auto end() const
+        requires std::ranges::random_access_range<V const>
+    {
+        return iterator<true>(end_tag, this);
+    }
+
+    constexpr std::size_t size() const
+    {
+        std::size_t size{ 1 };
+
+        for (auto const extent : extents_)
+        {
+            size *= extent;
+        }
+
+        return size;
+    }
+
+    constexpr extents_type const& extents() const
+    {
+        return extents_;
+    }
+
+    constexpr strides_type const& strides() const
+    {
+        return strides_;
+    }
+
+    constexpr std::size_t extent(std::size_t d) const
+    {
+        return extents_[d];
+    }
+
+    constexpr std::ptrdiff_t stride(std::size_t d) const
+    {
+        return strides_[d];
+    }
+
+    //Element at a multi-index, like std::mdspan::operator[]
+    constexpr decltype(auto) at(extents_type const& indices)
+    {
+        return std::ranges::begin(base_)[offset_of(indices)];
+    }
+
+    constexpr decltype(auto) at(extents_type const& indices) const
+        requires std::ranges::random_access_range<V const>
+    {
+        return std::ranges::begin(base_)[offset_of(indices)];
+    }
+
+    //Fixes dimension D at index i, e.g. slice<0>(i) is row i and slice<1>(j) is column j of a matrix
+    template <std::size_t D>
+    requires (D < N) && (N > 1)
+    constexpr auto slice(std::size_t i) const
+        requires std::copy_constructible<V>
+    {
+        std::array<std::size_t, N - 1> extents{};
+        std::array<std::ptrdiff_t, N - 1> strides{};
+
+        for (std::size_t d{ 0 }, k{ 0 }; d < N; ++d)
+        {
+            if (d != D)
+            {
+                extents[k] = extents_[d];
+                strides[k] = strides_[d];
+                ++k;
+            }
+        }
+
+        return strided_nd_view<V, N - 1>{ base_, extents, strides, offset_ + static_cast<std::ptrdiff_t>(i) * strides_[D] };
+    }
+
+    constexpr auto row(std::size_t i) const
+        requires (N == 2) && std::copy_constructible<V>
+    {
+        return slice<0>(i);
+    }
+
+    constexpr auto column(std::size_t j) const
+        requires (N == 2) && std::copy_constructible<V>
+    {
+        return slice<1>(j);
+    }
+
+    //The box of the given extents starting at first, clamped to the view
+    constexpr auto tile(extents_type const& first, extents_type const& extents) const
+        requires std::copy_constructible<V>
+    {
+        extents_type clamped{};
+        auto offset{ offset_ };
+
+        for (std::size_t d{ 0 }; d < N; ++d)
+        {
+            auto const begin{ std::min(first[d], extents_[d]) };
+
+            clamped[d] = std::min(extents[d], extents_[d] - begin);
+            offset += static_cast<std::ptrdiff_t>(begin) * strides_[d];
+        }
+
+        return strided_nd_view{ base_, clamped, strides_, offset };
+    }
+
+    //Random access range of the tiles that cover the view, in row-major order of tiles
+    //Walking each tile before moving on touches a cache-sized block at a time instead of whole rows;
+    //tiles(t) | std::views::join visits every element once in that order
+    constexpr auto tiles(extents_type const& tile_extents) const
+        requires std::copy_constructible<V>
+    {
+        extents_type counts{};
+        std::size_t count{ 1 };
+
+        for (std::size_t d{ 0 }; d < N; ++d)
+        {
+            counts[d] = tile_extents[d] == 0 ? 0 : (extents_[d] + tile_extents[d] - 1) / tile_extents[d];
+            count *= counts[d];
+        }
+
+        return std::views::iota(std::size_t{ 0 }, count)
+            | std::views::transform([view = *this, counts, tile_extents](std::size_t t) {
+                extents_type first{};
+
+                for (auto d{ N }; d-- > 0;)
+                {
+                    first[d] = t % counts[d] * tile_extents[d];
+                    t /= counts[d];
+                }
+
+                return view.tile(first, tile_extents);
+                });
+    }
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base()&&
+    {
+        return std::move(base_);
+    }
+};
+
+template <typename R, std::size_t N>
+strided_nd_view(R&&, std::array<std::size_t, N> const&)->strided_nd_view<std::views::all_t<R>, N>;
+
+template <typename R, std::size_t N>
+strided_nd_view(R&&, std::array<std::size_t, N> const&, std::array<std::ptrdiff_t, N> const&, std::ptrdiff_t = 0)->strided_nd_view<std::views::all_t<R>, N>;
+
+namespace views
+{
+    namespace detail
+    {
+        class strided_nd_fn
+        {
+        public:
+            //Dense row-major array of the given extents, e.g. strided_nd(pixels, { height, width })
+            template <std::ranges::viewable_range R, std::size_t N>
+            constexpr auto operator()(R&& r, std::size_t const (&extents)[N]) const
+            {
+                return strided_nd_view{ std::forward<R>(r), std::to_array(extents) };
+            }
+
+            template <std::ranges::viewable_range R, std::size_t N>
+            constexpr auto operator()(R&& r, std::array<std::size_t, N> const& extents) const
+            {
+                return strided_nd_view{ std::forward<R>(r), extents };
+            }
+
+            //Explicit strides in elements and offset of the first element, like std::layout_stride
+            template <std::ranges::viewable_range R, std::size_t N>
+            constexpr auto operator()(R&& r, std::array<std::size_t, N> const& extents, std::array<std::ptrdiff_t, N> const& strides, std::ptrdiff_t offset = 0) const
+            {
+                return strided_nd_view{ std::forward<R>(r), extents, strides, offset };
+            }
+        };
+    }
+
+    inline constexpr detail::strided_nd_fn strided_nd;
+}
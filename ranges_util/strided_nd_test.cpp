@@ -0,0 +1,150 @@
+#include "strided_nd.h"
+#include <algorithm>
+#include <array>
+#include <catch.hpp>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	std::vector<int> iota_vector(int n)
+	{
+		std::vector<int> v(n);
+		std::iota(std::begin(v), std::end(v), 0);
+
+		return v;
+	}
+}
+
+TEST_CASE("strided_nd steps back from the end")
+{
+	auto const v{ iota_vector(12) };
+	auto const m{ views::strided_nd(v, { 3, 4 }) };
+
+	auto it{ m.end() };
+
+	REQUIRE(*--it == 11);
+	REQUIRE(it.indices() == std::array<std::size_t, 2>{ 2, 3 });
+	REQUIRE(*--it == 10);
+	REQUIRE(*(m.end() - 1) == 11);
+	REQUIRE(std::ranges::equal(m | std::views::reverse, v | std::views::reverse));
+
+	auto const column{ m.column(1) };
+	auto last{ column.end() };
+
+	REQUIRE(*--last == 9);
+}
+
+TEST_CASE("strided_nd jumps across row carries")
+{
+	auto const v{ iota_vector(60) };
+	//Rows of 5 out of every 6 elements, 3 x 3 x 5 starting at 2
+	auto const m{ views::strided_nd(v, std::array<std::size_t, 3>{ 3, 3, 5 }, std::array<std::ptrdiff_t, 3>{ 18, 6, 1 }, 2) };
+
+	std::vector<int> expected;
+
+	for (int i{ 0 }; i < 3; ++i)
+	{
+		for (int j{ 0 }; j < 3; ++j)
+		{
+			for (int k{ 0 }; k < 5; ++k)
+			{
+				expected.push_back(2 + 18 * i + 6 * j + k);
+			}
+		}
+	}
+
+	REQUIRE(std::ranges::equal(m, expected));
+	REQUIRE(m.end() - m.begin() == std::ssize(expected));
+
+	for (std::ptrdiff_t a{ 0 }; a <= std::ssize(expected); ++a)
+	{
+		for (std::ptrdiff_t b{ 0 }; b <= std::ssize(expected); ++b)
+		{
+			auto it{ m.begin() + a };
+
+			it += b - a;
+
+			REQUIRE(it == m.begin() + b);
+			REQUIRE(it - m.begin() == b);
+			REQUIRE((m.begin() + a) - (m.begin() + b) == a - b);
+
+			if (b < std::ssize(expected))
+			{
+				REQUIRE(*it == expected[b]);
+			}
+		}
+	}
+
+	auto it{ m.begin() + 4 };
+
+	REQUIRE(*++it == 8);
+	REQUIRE(*--it == 6);
+	REQUIRE(*(it -= 1) == 5);
+}
+
+TEST_CASE("strided_nd with a zero extent is empty")
+{
+	auto const v{ iota_vector(12) };
+
+	for (auto const extents : { std::array<std::size_t, 2>{ 0, 4 }, std::array<std::size_t, 2>{ 3, 0 }, std::array<std::size_t, 2>{ 0, 0 } })
+	{
+		auto const m{ views::strided_nd(v, extents) };
+
+		REQUIRE(m.size() == 0);
+		REQUIRE(m.begin() == m.end());
+		REQUIRE(m.end() - m.begin() == 0);
+		REQUIRE(std::ranges::empty(m.tiles({ 2, 2 })));
+	}
+
+	auto const m{ views::strided_nd(v, { 3, 4 }) };
+
+	REQUIRE(std::ranges::empty(m.tiles({ 0, 2 })));
+	REQUIRE(m.tile({ 1, 4 }, { 2, 2 }).size() == 0);
+}
+
+TEST_CASE("strided_nd tiles joined visit every element tile by tile")
+{
+	auto const v{ iota_vector(20) };
+	auto const m{ views::strided_nd(v, { 4, 5 }) };
+	auto const tiles{ m.tiles({ 3, 2 }) };
+
+	REQUIRE(std::size(tiles) == 6);
+	REQUIRE(tiles[5].extents() == std::array<std::size_t, 2>{ 1, 1 });
+
+	std::vector<int> joined;
+
+	for (auto const e : tiles | std::views::join)
+	{
+		joined.push_back(e);
+	}
+
+	REQUIRE(joined == std::vector{
+		0, 1, 5, 6, 10, 11,
+		2, 3, 7, 8, 12, 13,
+		4, 9, 14,
+		15, 16,
+		17, 18,
+		19 });
+}
+
+TEST_CASE("strided_nd rejects layouts that reach outside of the base")
+{
+	using extents = std::array<std::size_t, 2>;
+	using strides = std::array<std::ptrdiff_t, 2>;
+
+	auto const v{ iota_vector(10) };
+
+	REQUIRE_THROWS_AS(views::strided_nd(v, { 3, 4 }), std::out_of_range);
+	REQUIRE_THROWS_AS(views::strided_nd(v, extents{ 2, 2 }, strides{ 5, 1 }, 4), std::out_of_range);
+	REQUIRE_THROWS_AS(views::strided_nd(v, extents{ 2, 2 }, strides{ -1, 1 }), std::out_of_range);
+	REQUIRE_THROWS_AS(views::strided_nd(v, std::array<std::size_t, 1>{ 2 }, std::array<std::ptrdiff_t, 1>{ 1 }, -1), std::out_of_range);
+
+	//Reversed rows ending on the first element and a layout touching the last one are fine, as is one with no elements
+	REQUIRE(std::ranges::equal(views::strided_nd(v, extents{ 2, 5 }, strides{ -5, 1 }, 5), std::vector{ 5, 6, 7, 8, 9, 0, 1, 2, 3, 4 }));
+	REQUIRE(std::ranges::equal(views::strided_nd(v, extents{ 2, 2 }, strides{ 5, 3 }, 1), std::vector{ 1, 4, 6, 9 }));
+	REQUIRE(views::strided_nd(v, { 0, 40 }).size() == 0);
+}
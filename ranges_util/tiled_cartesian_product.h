@@ -0,0 +1,265 @@
+#pragma once
+
+#include "common.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+
+//Same tuples as cartesian_product_view, visited tile by tile instead of in lexicographic order
+//Every dimension is cut into tiles of tile_size elements; the tiles are walked lexicographically and so are
+//the tuples inside a tile, so an all-pairs loop keeps reusing a block of each range that fits in cache
+//Only worth it when the later ranges do not fit in cache and the work per tuple is cheap next to loading it;
+//otherwise the plain cartesian_product is faster, since the tile bookkeeping buys nothing
+//e.g. views::tiled_cartesian_product(2, a, b) over a = b = { 0, 1, 2 } yields
+//(0,0) (0,1) (1,0) (1,1) (0,2) (1,2) (2,0) (2,1) (2,2)
+template <std::ranges::forward_range... Ts>
+requires (std::ranges::view<Ts> && ...) && (sizeof...(Ts) > 0)
+class tiled_cartesian_product_view
+    : public std::ranges::view_interface<tiled_cartesian_product_view<Ts...>>
+{
+    std::tuple<Ts...> bases_;
+    std::size_t tile_size_ = 1;
+
+    template <bool Const>
+    class iterator
+    {
+        template<typename T>
+        using constify = std::conditional_t<Const, const T, T>;
+
+        using currents_type = std::tuple<std::ranges::iterator_t<constify<Ts>>...>;
+
+        constify<std::tuple<Ts...>>* bases_ = nullptr;
+        std::size_t tile_size_ = 1;
+        currents_type currents_{};
+        //[tile_begins_, tile_ends_) is the part of every base covered by the current tile
+        currents_type tile_begins_{};
+        currents_type tile_ends_{};
+
+        template <std::size_t N>
+        constexpr auto tile_end(std::ranges::iterator_t<constify<std::tuple_element_t<N, std::tuple<Ts...>>>> first) const
+        {
+            std::ranges::advance(first, static_cast<std::ranges::range_difference_t<std::tuple_element_t<N, std::tuple<Ts...>>>>(tile_size_),
+                std::ranges::end(std::get<N>(*bases_)));
+
+            return first;
+        }
+
+        template <std::size_t N = 0>
+        constexpr void first_tile()
+        {
+            auto const& base{ std::get<N>(*bases_) };
+
+            std::get<N>(tile_begins_) = std::ranges::begin(base);
+            std::get<N>(tile_ends_) = tile_end<N>(std::get<N>(tile_begins_));
+            std::get<N>(currents_) = std::get<N>(tile_begins_);
+
+            if constexpr (N + 1 < sizeof...(Ts))
+            {
+                first_tile<N + 1>();
+            }
+        }
+
+        //Lexicographic increment inside the current tile
+        //Returns false once every tuple of the tile has been visited
+        template <std::size_t N = (sizeof...(Ts) - 1)>
+        constexpr bool next_in_tile()
+        {
+            auto& it{ std::get<N>(currents_) };
+
+            if (++it != std::get<N>(tile_ends_))
+            {
+                return true;
+            }
+
+            it = std::get<N>(tile_begins_);
+
+            if constexpr (N > 0)
+            {
+                return next_in_tile<N - 1>();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        //Move to the next tile of dimension N
+        //If dimension N runs out of tiles, restart it and recurse to dimension N-1; dimension 0 running out is the end
+        template <std::size_t N = (sizeof...(Ts) - 1)>
+        constexpr void next_tile()
+        {
+            auto& first{ std::get<N>(tile_begins_) };
+            auto& last{ std::get<N>(tile_ends_) };
+            auto const& base{ std::get<N>(*bases_) };
+
+            first = last;
+
+            if constexpr (N > 0)
+            {
+                if (first == std::ranges::end(base))
+                {
+                    first = std::ranges::begin(base);
+                    next_tile<N - 1>();
+                }
+            }
+
+            last = tile_end<N>(first);
+            std::get<N>(currents_) = first;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::tuple<std::ranges::range_reference_t<constify<Ts>>...>;
+        using value_type = std::tuple<std::ranges::range_value_t<constify<Ts>>...>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        constexpr explicit iterator(begin_tag_t, constify<std::tuple<Ts...>>* bases, std::size_t tile_size)
+            : bases_{ bases }, tile_size_{ tile_size }
+        {
+            first_tile();
+
+            //An empty base anywhere makes the whole product empty
+            if (std::apply([](auto const&... bs) { return (std::ranges::empty(bs) || ...); }, *bases_))
+            {
+                std::ranges::advance(std::get<0>(currents_), std::ranges::end(std::get<0>(*bases_)));
+            }
+        }
+
+        constexpr iterator(iterator<!Const> i) requires Const && (std::convertible_to<std::ranges::iterator_t<Ts>, std::ranges::iterator_t<constify<Ts>>> && ...)
+            : bases_{ i.bases_ }, tile_size_{ i.tile_size_ }, currents_{ std::move(i.currents_) },
+            tile_begins_{ std::move(i.tile_begins_) }, tile_ends_{ std::move(i.tile_ends_) }
+        {
+
+        }
+
+        constexpr decltype(auto) operator*() const
+        {
+            return std::apply([](auto const&... currents) {
+                return reference{ *currents... };
+                }, currents_);
+        }
+
+        constexpr iterator& operator++()
+        {
+            if (!next_in_tile())
+            {
+                next_tile();
+            }
+
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto const temp{ *this };
+
+            ++*this;
+
+            return temp;
+        }
+
+        friend constexpr bool operator==(iterator const& x, iterator const& y)
+            requires (std::equality_comparable<std::ranges::iterator_t<constify<Ts>>> && ...)
+        {
+            return x.currents_ == y.currents_;
+        }
+
+        //Inside a tile the first iterator only moves within [tile_begin, tile_end), so it reaches the end of its base
+        //only after the last tile
+        friend constexpr bool operator==(iterator const& x, std::default_sentinel_t const&)
+        {
+            return std::get<0>(x.currents_) == std::ranges::end(std::get<0>(*x.bases_));
+        }
+
+        friend class iterator<!Const>;
+    };
+
+public:
+    //Tile edge that lets one tile of every base fit in a typical 32KiB L1 data cache
+    static constexpr std::size_t default_tile_size(std::size_t cache_size = 32 * 1024)
+    {
+        return std::max<std::size_t>(1, cache_size / (sizeof(std::ranges::range_value_t<Ts>) + ...));
+    }
+
+    tiled_cartesian_product_view() = default;
+
+    explicit tiled_cartesian_product_view(std::size_t tile_size, Ts... bases)
+        : bases_(std::move(bases)...), tile_size_{ std::max<std::size_t>(tile_size, 1) }
+    {
+
+    }
+
+    constexpr auto begin()
+        requires (!(simple_view<Ts> && ...))
+    {
+        return iterator<false>(begin_tag, std::addressof(bases_), tile_size_);
+    }
+
+    constexpr auto begin() const
+        requires (std::ranges::forward_range<const Ts> && ...)
+    {
+        return iterator<true>(begin_tag, std::addressof(bases_), tile_size_);
+    }
+
+    constexpr auto end() const
+    {
+        return std::default_sentinel;
+    }
+
+    constexpr auto size() requires (std::ranges::sized_range<Ts> && ...)
+    {
+        return std::apply([](auto&&... bases) {
+            using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
+            return (static_cast<size_type>(std::ranges::size(bases)) * ...);
+            }, bases_);
+    }
+
+    constexpr auto size() const requires (std::ranges::sized_range<const Ts> && ...)
+    {
+        return std::apply([](auto&&... bases) {
+            using size_type = std::common_type_t<std::ranges::range_size_t<decltype(bases)>...>;
+            return (static_cast<size_type>(std::ranges::size(bases)) * ...);
+            }, bases_);
+    }
+
+    constexpr std::size_t tile_size() const
+    {
+        return tile_size_;
+    }
+};
+
+template <typename... Ts>
+tiled_cartesian_product_view(std::size_t, Ts&&...)->tiled_cartesian_product_view<std::views::all_t<Ts>...>;
+
+namespace views
+{
+    namespace detail
+    {
+        class tiled_cartesian_product_fn
+        {
+        public:
+            template <std::ranges::viewable_range... Ts>
+            constexpr auto operator()(std::size_t tile_size, Ts&&... ts) const
+            {
+                return tiled_cartesian_product_view{ tile_size, std::views::all(std::forward<Ts>(ts))... };
+            }
+
+            //Tile size picked by default_tile_size() for an L1 sized cache
+            template <std::ranges::viewable_range... Ts>
+            requires (sizeof...(Ts) > 0) && (!std::convertible_to<std::tuple_element_t<0, std::tuple<Ts...>>, std::size_t>)
+            constexpr auto operator()(Ts&&... ts) const
+            {
+                using view_type = tiled_cartesian_product_view<std::views::all_t<Ts>...>;
+
+                return view_type{ view_type::default_tile_size(), std::views::all(std::forward<Ts>(ts))... };
+            }
+        };
+    }
+
+    inline constexpr detail::tiled_cartesian_product_fn tiled_cartesian_product;
+}
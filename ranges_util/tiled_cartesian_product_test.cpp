@@ -0,0 +1,76 @@
+#include "cartesian_product.h"
+#include "tiled_cartesian_product.h"
+#include <algorithm>
+#include <catch.hpp>
+#include <cstddef>
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	template <typename R>
+	std::vector<std::tuple<int, int, int>> tuples(R const& r)
+	{
+		std::vector<std::tuple<int, int, int>> out;
+
+		for (auto const& [x, y, z] : r)
+		{
+			out.emplace_back(x, y, z);
+		}
+
+		return out;
+	}
+}
+
+TEST_CASE("tiled_cartesian_product visits the tuples of cartesian_product once each")
+{
+	std::vector const a{ 1, 2, 3, 4, 5 };
+	std::list const b{ 10, 20, 30 };
+	std::vector const c{ 100, 200, 300, 400, 500, 600, 700 };
+
+	auto expected{ tuples(views::cartesian_product(a, b, c)) };
+	std::ranges::sort(expected);
+
+	//1 is the plain lexicographic order, 100 is a single tile larger than every base
+	for (std::size_t tile_size : { 1, 2, 3, 4, 100 })
+	{
+		auto visited{ tuples(views::tiled_cartesian_product(tile_size, a, b, c)) };
+
+		if (tile_size == 1 || tile_size == 100)
+		{
+			REQUIRE(visited == tuples(views::cartesian_product(a, b, c)));
+		}
+
+		std::ranges::sort(visited);
+
+		REQUIRE(visited == expected);
+	}
+}
+
+TEST_CASE("tiled_cartesian_product walks the tuples of a tile before the next tile")
+{
+	std::vector const a{ 0, 1, 2 };
+	std::vector<std::pair<int, int>> visited;
+
+	for (auto const& [x, y] : views::tiled_cartesian_product(2, a, a))
+	{
+		visited.emplace_back(x, y);
+	}
+
+	REQUIRE(visited == std::vector<std::pair<int, int>>{ { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 }, { 0, 2 }, { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 } });
+}
+
+TEST_CASE("tiled_cartesian_product with an empty base is empty")
+{
+	std::vector const a{ 1, 2, 3 };
+	std::vector<int> const empty;
+
+	for (std::size_t tile_size : { 1, 2, 100 })
+	{
+		REQUIRE(tuples(views::tiled_cartesian_product(tile_size, empty, a, a)).empty());
+		REQUIRE(tuples(views::tiled_cartesian_product(tile_size, a, empty, a)).empty());
+		REQUIRE(tuples(views::tiled_cartesian_product(tile_size, a, a, empty)).empty());
+	}
+}
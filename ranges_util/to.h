@@ -16,6 +16,15 @@ namespace detail
     template <typename>
     constexpr inline bool always_false = false;
 
+    //R can append all of its elements to C in bulk (e.g. cycle_n_view::append_to)
+    template <typename C, typename R>
+    concept bulk_appendable = std::ranges::sized_range<R> &&
+        std::same_as<std::ranges::range_value_t<C>, std::ranges::range_value_t<R>> &&
+        requires (C& c, R& r)
+    {
+        r.append_to(c);
+    };
+
     //R is a nested range that can be converted to the nested container C
     template <typename C, typename R>
     concept matroshkable = std::ranges::input_range<C> && std::ranges::input_range<R> &&
@@ -93,7 +102,14 @@ constexpr C to(R&& r, Args&&... args)
             c.reserve(std::ranges::size(r));
         }
 
-        std::ranges::copy(std::forward<R>(r), std::inserter(c, std::end(c)));
+        if constexpr (detail::bulk_appendable<C, R>)
+        {
+            r.append_to(c);
+        }
+        else
+        {
+            std::ranges::copy(std::forward<R>(r), std::inserter(c, std::end(c)));
+        }
 
         return c;
     }